@@ -38,6 +38,20 @@ Eigen::ArrayXd MSSMcbs<Two_scale>::beta() const
    return calc_beta().get();
 }
 
+void MSSMcbs<Two_scale>::beta_into(Eigen::ArrayXd& dydx) const
+{
+   dydx = beta();
+}
+
+/**
+ * The fixed-size RG running of CMSSM<Two_scale> does not call the
+ * beta functions of this class, so the generic running is used.
+ */
+void MSSMcbs<Two_scale>::run(double x1, double x2, double eps)
+{
+   Beta_function::run(x1, x2, eps);
+}
+
 CMSSM_soft_parameters MSSMcbs<Two_scale>::calc_beta() const
 {
    CMSSM_soft_parameters betas(CMSSM<Two_scale>::calc_beta());
@@ -31,6 +31,8 @@ public:
    virtual ~MSSMcbs();
 
    virtual Eigen::ArrayXd beta() const;
+   virtual void beta_into(Eigen::ArrayXd&) const;
+   virtual void run(double, double, double eps = -1.0);
    CMSSM_soft_parameters calc_beta() const;
 };
 
@@ -55,6 +55,9 @@ to C form";
 CreateEWSBRootFinders::usage="Creates comma separated list of GSL root
 finders";
 
+CreateEWSBRootFinderCases::usage="Creates switch cases, which return
+the i-th GSL root finder";
+
 SetEWSBSolution::usage="sets the model parameters to the solution
 provided by the solver";
 
@@ -233,12 +236,12 @@ GetValueWithPhase[parameter_, gslIntputVector_String, index_Integer, freePhases_
            WrapPhase[freePhase, gslInput, "INPUT"]
           ];
 
-FillArrayWithEWSBEqs[higgs_, gslOutputVector_String] :=
+FillArrayWithEWSBEqs[higgs_, gslOutputVector_String, prefix_String:""] :=
     Module[{i, result = "", par, dim},
            dim = TreeMasses`GetDimension[higgs];
            For[i = 1, i <= dim, i++,
                result = result <> gslOutputVector <> "[" <> ToString[i-1] <>
-                        "] = " <> "get_ewsb_eq_" <>
+                        "] = " <> prefix <> "get_ewsb_eq_" <>
                         CConversion`ToValidCSymbolString[higgs] <> "_" <>
                         ToString[i] <> "();\n";
               ];
@@ -935,6 +938,15 @@ CreateEWSBRootFinder[rootFinder_ /; rootFinder === FlexibleSUSY`GSLBroyden] :=
 CreateEWSBRootFinder[rootFinder_ /; rootFinder === FlexibleSUSY`GSLNewton] :=
     CreateNewEWSBRootFinder[] <> "Root_finder<number_of_ewsb_equations>::GSLNewton)";
 
+CreateNewEWSBRootFinderWithJacobian[] :=
+    "new Root_finder<number_of_ewsb_equations>(tadpole_stepper, tadpole_jacobian, number_of_iterations, precision, ";
+
+CreateEWSBRootFinder[rootFinder_ /; rootFinder === FlexibleSUSY`GSLHybridSJ] :=
+    CreateNewEWSBRootFinderWithJacobian[] <> "Root_finder<number_of_ewsb_equations>::GSLHybridSJ)";
+
+CreateEWSBRootFinder[rootFinder_ /; rootFinder === FlexibleSUSY`GSLNewtonJ] :=
+    CreateNewEWSBRootFinderWithJacobian[] <> "Root_finder<number_of_ewsb_equations>::GSLNewtonJ)";
+
 CreateEWSBRootFinders[{}] :=
     Block[{},
           Print["Error: List of EWSB root finders must not be empty!"];
@@ -947,6 +959,13 @@ MakeUniquePtr[str_String, obj_String] :=
 CreateEWSBRootFinders[rootFinders_List] :=
     Utils`StringJoinWithSeparator[MakeUniquePtr[#,"EWSB_solver"]& /@ (CreateEWSBRootFinder /@ rootFinders), ",\n"];
 
+CreateEWSBRootFinderCases[{}] := CreateEWSBRootFinders[{}];
+
+CreateEWSBRootFinderCases[rootFinders_List] :=
+    StringJoin[MapIndexed["case " <> ToString[First[#2] - 1] <> ": return " <>
+                          MakeUniquePtr[#1, "EWSB_solver"] <> ";\n"&,
+                          CreateEWSBRootFinder /@ rootFinders]];
+
 ConvertToReal[par_] :=
     If[Parameters`IsRealParameter[par],
        CConversion`ToValidCSymbolString[par],
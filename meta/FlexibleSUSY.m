@@ -291,6 +291,8 @@ GSLHybrid;   (* hybrid method *)
 GSLHybridS;  (* hybrid method with dynamic step size *)
 GSLBroyden;  (* Broyden method *)
 GSLNewton;   (* Newton method *)
+GSLHybridSJ; (* hybrid method with dynamic step size and tree-level Jacobian *)
+GSLNewtonJ;  (* Newton method with tree-level Jacobian *)
 FPIRelative; (* Fixed point iteration, convergence crit. relative step size *)
 FPIAbsolute; (* Fixed point iteration, convergence crit. absolute step size *)
 FPITadpole;  (* Fixed point iteration, convergence crit. relative step size + tadpoles *)
@@ -387,6 +389,7 @@ GetBetaFunctions[] := allBetaFunctions;
 numberOfModelParameters = 0;
 
 allEWSBSolvers = { GSLHybrid, GSLHybridS, GSLBroyden, GSLNewton,
+                   GSLHybridSJ, GSLNewtonJ,
                    FPIRelative, FPIAbsolute, FPITadpole };
 
 allBVPSolvers = { TwoScaleSolver, LatticeSolver, SemiAnalyticSolver };
@@ -1427,8 +1430,9 @@ WriteEWSBSolverClass[ewsbEquations_List, parametersFixedByEWSB_List, ewsbInitial
     Module[{numberOfIndependentEWSBEquations,
             ewsbEquationsTreeLevel, independentEwsbEquationsTreeLevel,
             independentEwsbEquations, higgsToEWSBEqAssociation,
+            calculateTreeLevelTadpolesNoStruct = "",
             calculateOneLoopTadpolesNoStruct = "", calculateTwoLoopTadpolesNoStruct = "",
-            ewsbInitialGuess = "", solveEwsbTreeLevel = "", setTreeLevelSolution = "", EWSBSolvers = "",
+            ewsbInitialGuess = "", solveEwsbTreeLevel = "", setTreeLevelSolution = "", EWSBSolverCases = "",
             setEWSBSolution = "", fillArrayWithEWSBParameters = "",
             solveEwsbWithTadpoles = "", getEWSBParametersFromVector = "",
             setEWSBParametersFromLocalCopies = "", applyEWSBSubstitutions = "",
@@ -1446,6 +1450,7 @@ WriteEWSBSolverClass[ewsbEquations_List, parametersFixedByEWSB_List, ewsbInitial
 	      Quit[1];
              ];
            higgsToEWSBEqAssociation     = CreateHiggsToEWSBEqAssociation[];
+           calculateTreeLevelTadpolesNoStruct = EWSB`FillArrayWithEWSBEqs[SARAH`HiggsBoson, "tadpole", "model."];
            calculateOneLoopTadpolesNoStruct = SelfEnergies`FillArrayWithLoopTadpoles[1, higgsToEWSBEqAssociation, "tadpole", "+", "model."];
            If[SARAH`UseHiggs2LoopMSSM === True || FlexibleSUSY`UseHiggs2LoopNMSSM === True,
               calculateTwoLoopTadpolesNoStruct = SelfEnergies`FillArrayWithTwoLoopTadpoles[SARAH`HiggsBoson, "tadpole", "+", "model."];
@@ -1453,7 +1458,7 @@ WriteEWSBSolverClass[ewsbEquations_List, parametersFixedByEWSB_List, ewsbInitial
            ewsbInitialGuess             = EWSB`FillInitialGuessArray[parametersFixedByEWSB, ewsbInitialGuessValues];
            solveEwsbTreeLevel           = EWSB`CreateTreeLevelEwsbSolver[ewsbSolution /. FlexibleSUSY`tadpole[_] -> 0];
            setTreeLevelSolution         = EWSB`SetTreeLevelSolution[ewsbSolution, ewsbSubstitutions];
-           EWSBSolvers                  = EWSB`CreateEWSBRootFinders[allowedEwsbSolvers];
+           EWSBSolverCases              = EWSB`CreateEWSBRootFinderCases[allowedEwsbSolvers];
            setEWSBSolution              = EWSB`SetEWSBSolution[parametersFixedByEWSB, freePhases, "solution", "model."];
            If[ewsbSolution =!= {},
               fillArrayWithEWSBParameters  = EWSB`FillArrayWithParameters["ewsb_parameters", parametersFixedByEWSB];
@@ -1464,13 +1469,15 @@ WriteEWSBSolverClass[ewsbEquations_List, parametersFixedByEWSB_List, ewsbInitial
            setModelParametersFromEWSB   = EWSB`SetModelParametersFromEWSB[parametersFixedByEWSB, ewsbSubstitutions, "model."];
            applyEWSBSubstitutions       = EWSB`ApplyEWSBSubstitutions[parametersFixedByEWSB, ewsbSubstitutions];
            WriteOut`ReplaceInFiles[files,
-                          { "@calculateOneLoopTadpolesNoStruct@" -> IndentText[calculateOneLoopTadpolesNoStruct],
+                          { "@calculateTreeLevelTadpolesNoStruct@" -> IndentText[IndentText[calculateTreeLevelTadpolesNoStruct]],
+                            "@calculateOneLoopTadpolesNoStruct@" -> IndentText[calculateOneLoopTadpolesNoStruct],
                             "@calculateTwoLoopTadpolesNoStruct@" -> IndentText[calculateTwoLoopTadpolesNoStruct],
                             "@numberOfEWSBEquations@"-> ToString[TreeMasses`GetDimension[SARAH`HiggsBoson]],
                             "@ewsbInitialGuess@"       -> IndentText[ewsbInitialGuess],
                             "@solveEwsbTreeLevel@"           -> IndentText[WrapLines[solveEwsbTreeLevel]],
                             "@setTreeLevelSolution@"         -> IndentText[WrapLines[setTreeLevelSolution]],
-                            "@EWSBSolvers@"                  -> IndentText[IndentText[EWSBSolvers]],
+                            "@numberOfEWSBSolvers@"          -> ToString[Length[allowedEwsbSolvers]],
+                            "@EWSBSolverCases@"              -> IndentText[EWSBSolverCases],
                             "@fillArrayWithEWSBParameters@"  -> IndentText[fillArrayWithEWSBParameters],
                             "@solveEwsbWithTadpoles@"        -> IndentText[WrapLines[solveEwsbWithTadpoles]],
                             "@getEWSBParametersFromVector@"  -> IndentText[IndentText[getEWSBParametersFromVector]],
@@ -1488,6 +1495,7 @@ WriteSemiAnalyticEWSBSolverClass[ewsbEquations_List, parametersFixedByEWSB_List,
     Module[{semiAnalyticSubs, additionalEwsbSubs, numberOfIndependentEWSBEquations,
             ewsbEquationsTreeLevel,
             independentEwsbEquations, higgsToEWSBEqAssociation,
+            calculateTreeLevelTadpolesNoStruct = "",
             calculateOneLoopTadpolesNoStruct = "", calculateTwoLoopTadpolesNoStruct = "",
             ewsbInitialGuess = "", solveEwsbTreeLevel = "", setTreeLevelSolution = "", EWSBSolvers = "",
             setEWSBSolution = "", fillArrayWithEWSBParameters = "",
@@ -1507,6 +1515,7 @@ WriteSemiAnalyticEWSBSolverClass[ewsbEquations_List, parametersFixedByEWSB_List,
 	      Quit[1];
              ];
            higgsToEWSBEqAssociation     = CreateHiggsToEWSBEqAssociation[];
+           calculateTreeLevelTadpolesNoStruct = EWSB`FillArrayWithEWSBEqs[SARAH`HiggsBoson, "tadpole", "model."];
            calculateOneLoopTadpolesNoStruct = SelfEnergies`FillArrayWithLoopTadpoles[1, higgsToEWSBEqAssociation, "tadpole", "+", "model."];
            If[SARAH`UseHiggs2LoopMSSM === True || FlexibleSUSY`UseHiggs2LoopNMSSM === True,
               calculateTwoLoopTadpolesNoStruct = SelfEnergies`FillArrayWithTwoLoopTadpoles[SARAH`HiggsBoson, "tadpole", "+", "model."];
@@ -1527,7 +1536,8 @@ WriteSemiAnalyticEWSBSolverClass[ewsbEquations_List, parametersFixedByEWSB_List,
            setModelParametersFromEWSB   = EWSB`SetModelParametersFromEWSB[parametersFixedByEWSB, additionalEwsbSubs, "model."];
            applyEWSBSubstitutions       = EWSB`ApplyEWSBSubstitutions[parametersFixedByEWSB, additionalEwsbSubs];
            WriteOut`ReplaceInFiles[files,
-                          { "@calculateOneLoopTadpolesNoStruct@" -> IndentText[calculateOneLoopTadpolesNoStruct],
+                          { "@calculateTreeLevelTadpolesNoStruct@" -> IndentText[IndentText[calculateTreeLevelTadpolesNoStruct]],
+                            "@calculateOneLoopTadpolesNoStruct@" -> IndentText[calculateOneLoopTadpolesNoStruct],
                             "@calculateTwoLoopTadpolesNoStruct@" -> IndentText[calculateTwoLoopTadpolesNoStruct],
                             "@numberOfEWSBEquations@"-> ToString[TreeMasses`GetDimension[SARAH`HiggsBoson]],
                             "@ewsbInitialGuess@"       -> IndentText[ewsbInitialGuess],
@@ -1583,8 +1593,10 @@ WriteModelClass[massMatrices_List, ewsbEquations_List,
             calculateOneLoopTadpoles = "", calculateTwoLoopTadpoles = "",
             physicalMassesDef = "", mixingMatricesDef = "",
             massCalculationPrototypes = "", massCalculationFunctions = "",
-            calculateAllMasses = "",
+            calculateAllMasses = "", calculateEWSBDependentMasses = "",
+            ewsbDependentParameters,
             selfEnergyPrototypes = "", selfEnergyFunctions = "",
+            couplingCacheMembers = "", fillCouplingCache = "", clearCouplingCache = "",
             twoLoopTadpolePrototypes = "", twoLoopTadpoleFunctions = "",
             twoLoopSelfEnergyPrototypes = "", twoLoopSelfEnergyFunctions = "",
             threeLoopSelfEnergyPrototypes = "", threeLoopSelfEnergyFunctions = "",
@@ -1711,6 +1723,7 @@ WriteModelClass[massMatrices_List, ewsbEquations_List,
               {thirdGenerationHelperPrototypes, thirdGenerationHelperFunctions} = TreeMasses`CreateGenerationHelpers[3];
              ];
            {selfEnergyPrototypes, selfEnergyFunctions} = SelfEnergies`CreateNPointFunctions[nPointFunctions, vertexRules];
+           {couplingCacheMembers, fillCouplingCache, clearCouplingCache} = SelfEnergies`CreateCouplingCache[nPointFunctions, vertexRules];
            phasesDefinition             = Phases`CreatePhasesDefinition[phases];
            phasesGetterSetters          = Phases`CreatePhasesGetterSetters[phases];
            If[Parameters`GetExtraParameters[] =!= {},
@@ -1799,6 +1812,22 @@ WriteModelClass[massMatrices_List, ewsbEquations_List,
                                                    Im                    -> Identity
                                                }];
            saveEWSBOutputParameters = Parameters`SaveParameterLocally[parametersToSave];
+           ewsbDependentParameters =
+               DeleteDuplicates[Join[parametersToSave, parametersFixedByEWSB,
+                                     #[[1]]& /@ (Select[ewsbSubstitutions,
+                                                        Function[sub, Or @@ (!FreeQ[sub[[2]], #]& /@ parametersFixedByEWSB)]])] /.
+                                {
+                                    Susyno`LieGroups`conj -> Identity,
+                                    SARAH`Conj            -> Identity,
+                                    SARAH`Tp              -> Identity,
+                                    SARAH`Adj             -> Identity,
+                                    SARAH`bar             -> Identity,
+                                    Conjugate             -> Identity,
+                                    Transpose             -> Identity,
+                                    Re                    -> Identity,
+                                    Im                    -> Identity
+                                }];
+           calculateEWSBDependentMasses = TreeMasses`CallEWSBDependentMassCalculationFunctions[massMatrices, ewsbDependentParameters];
            (ewsbSolverHeaders = ewsbSolverHeaders
                                 <> EnableForBVPSolver[#, ("#include \"" <> FlexibleSUSY`FSModelName
                                                           <> "_" <> GetBVPSolverHeaderName[#] <> "_ewsb_solver.hpp\"\n")] <> "\n")&
@@ -1883,10 +1912,14 @@ WriteModelClass[massMatrices_List, ewsbEquations_List,
                             "@[override]massCalculationPrototypes@" -> IndentText[FunctionModifiers`MakeOverride[massCalculationPrototypes]],
                             "@massCalculationFunctions@"  -> WrapLines[massCalculationFunctions],
                             "@calculateAllMasses@"        -> IndentText[calculateAllMasses],
+                            "@calculateEWSBDependentMasses@" -> IndentText[calculateEWSBDependentMasses],
                             "@selfEnergyPrototypes@"      -> IndentText[selfEnergyPrototypes],
                             "@[abstract]selfEnergyPrototypes@" -> IndentText[FunctionModifiers`MakeAbstract[selfEnergyPrototypes]],
                             "@[override]selfEnergyPrototypes@" -> IndentText[FunctionModifiers`MakeOverride[selfEnergyPrototypes]],
                             "@selfEnergyFunctions@"       -> selfEnergyFunctions,
+                            "@couplingCacheMembers@"      -> IndentText[IndentText[couplingCacheMembers]],
+                            "@fillCouplingCache@"         -> IndentText[fillCouplingCache],
+                            "@clearCouplingCache@"        -> IndentText[clearCouplingCache],
                             "@twoLoopTadpolePrototypes@"  -> IndentText[twoLoopTadpolePrototypes],
                             "@twoLoopTadpoleFunctions@"   -> twoLoopTadpoleFunctions,
                             "@twoLoopSelfEnergyPrototypes@" -> IndentText[twoLoopSelfEnergyPrototypes],
@@ -1923,8 +1956,8 @@ WriteModelClass[massMatrices_List, ewsbEquations_List,
                             "@[abstract]runningDRbarMassesPrototypes@" -> IndentText[FunctionModifiers`MakeAbstract[runningDRbarMassesPrototypes]],
                             "@[override]runningDRbarMassesPrototypes@" -> IndentText[FunctionModifiers`MakeOverride[runningDRbarMassesPrototypes]],
                             "@runningDRbarMassesFunctions@"  -> WrapLines[runningDRbarMassesFunctions],
-                            "@callAllLoopMassFunctions@"     -> IndentText[callAllLoopMassFunctions],
-                            "@callAllLoopMassFunctionsInThreads@" -> IndentText[callAllLoopMassFunctionsInThreads],
+                            "@callAllLoopMassFunctions@"     -> IndentText[IndentText[callAllLoopMassFunctions]],
+                            "@callAllLoopMassFunctionsInThreads@" -> IndentText[IndentText[callAllLoopMassFunctionsInThreads]],
                             "@printMasses@"                  -> IndentText[printMasses],
                             "@getMixings@"                   -> IndentText[getMixings],
                             "@setMixings@"                   -> IndentText[setMixings],
@@ -2417,7 +2450,8 @@ RunEnabledSpectrumGenerator[solver_] :=
            class = GetBVPSolverTemplateParameter[solver];
            body = "exit_code = run_solver<" <> class <> ">(\n"
                   <> IndentText["slha_io, spectrum_generator_settings, slha_output_file,\n"]
-                  <> IndentText["database_output_file, spectrum_file, rgflow_file);\n"]
+                  <> IndentText["database_output_file, columnar_output_file,\n"]
+                  <> IndentText["spectrum_file, rgflow_file);\n"]
                   <> "if (!exit_code || solver_type != 0) break;\n";
            result = "case " <> key <> ":\n" <> IndentText[body];
            EnableForBVPSolver[solver, IndentText[result]] <> "\n"
@@ -2427,10 +2461,10 @@ ScanEnabledSpectrumGenerator[solver_] :=
     Module[{key = "", class = "", macro = "", body = "", result = ""},
            key = GetBVPSolverSLHAOptionKey[solver];
            class = GetBVPSolverTemplateParameter[solver];
-           body = "result = run_parameter_point<" <> class <> ">(loop_library, qedqcd, input);\n"
+           body = "result = run_parameter_point<" <> class <> ">(loop_library, qedqcd, input, columnar_output);\n"
                   <> "if (!result.problems.have_problem() || solver_type != 0) break;\n";
            result = "case " <> key <> ":\n" <> IndentText[body];
-           EnableForBVPSolver[solver, IndentText[IndentText[result]]] <> "\n"
+           EnableForBVPSolver[solver, IndentText[result]] <> "\n"
           ];
 
 RunCmdLineEnabledSpectrumGenerator[solver_] :=
@@ -504,6 +504,21 @@ DoFastDiagonalization[particle_Symbol, _] :=
 
 (* ********** medium diagonalization routines ********** *)
 
+(* calculates the loop-corrected mass matrices M_loop_es[es] of all
+   eigenstates es, in parallel if threads are enabled *)
+CalculateLoopMassMatrices[dimStr_String, matrixCType_String, body_String] :=
+    "std::array<" <> matrixCType <> ", " <> dimStr <> "> M_loop_es;\n\n" <>
+    "for_each_eigenstate(" <> dimStr <> ", [&] (int es) {\n" <>
+    IndentText[body <> "M_loop_es[es] = M_loop;\n"] <>
+    "});\n\n";
+
+(* diagonalizes the loop-corrected mass matrices in order *)
+DiagonalizeLoopMassMatrices[dimStr_String, matrixCType_String, body_String] :=
+    "for (int es = 0; es < " <> dimStr <> "; ++es) {\n" <>
+    IndentText["const " <> matrixCType <> "& M_loop = M_loop_es[es];\n"] <>
+    body <>
+    "}\n";
+
 DoMediumDiagonalization[particle_Symbol /; IsScalar[particle], inputMomentum_, tadpole_List, calcEffPot_:True] :=
     Module[{result, dim, dimStr, massName, particleName, mixingMatrix, selfEnergyFunction,
             momentum = inputMomentum, U, V, Utemp, Vtemp, tadpoleMatrix, diagSnippet,
@@ -573,16 +588,17 @@ DoMediumDiagonalization[particle_Symbol /; IsScalar[particle], inputMomentum_, t
               result = tadpoleMatrix <>
                        "const " <> selfEnergyMatrixCType <> " M_tree(" <> massMatrixStr <> "());\n" <>
                        calcHigherLoopHiggsContributions <> "\n" <>
-                       "for (int es = 0; es < " <> dimStr <> "; ++es) {\n" <>
-                       IndentText["const double p = Abs(" <> momentum <> "(es));\n" <>
-                                  selfEnergyMatrixCType <> " self_energy = " <> CastIfReal[selfEnergyFunction <> "(p)", selfEnergyMatrixType] <> ";\n" <>
-                                  addHigherLoopHiggsContributions <>
-                                  "const " <> selfEnergyMatrixCType <> " M_loop(M_tree - self_energy" <>
-                                  If[tadpoleMatrix == "", "", " + tadpoles"] <> ");\n" <>
-                                  eigenArrayType <> " eigen_values;\n" <>
-                                  diagSnippet
-                                 ] <>
-                       "}\n";
+                       CalculateLoopMassMatrices[
+                           dimStr, selfEnergyMatrixCType,
+                           "const double p = Abs(" <> momentum <> "(es));\n" <>
+                           selfEnergyMatrixCType <> " self_energy = " <> CastIfReal[selfEnergyFunction <> "(p)", selfEnergyMatrixType] <> ";\n" <>
+                           addHigherLoopHiggsContributions <>
+                           "const " <> selfEnergyMatrixCType <> " M_loop(M_tree - self_energy" <>
+                           If[tadpoleMatrix == "", "", " + tadpoles"] <> ");\n"] <>
+                       DiagonalizeLoopMassMatrices[
+                           dimStr, selfEnergyMatrixCType,
+                           IndentText[eigenArrayType <> " eigen_values;\n" <>
+                                      diagSnippet]];
               ,
               result = tadpoleMatrix <>
                        "const " <> selfEnergyMatrixCType <> " M_tree(" <> massMatrixStr <> "());\n" <>
@@ -600,7 +616,8 @@ DoMediumDiagonalization[particle_Symbol /; IsFermion[particle], inputMomentum_,
             eigenArrayType, mixingMatrixType, particleName,
             topSelfEnergyFunctionS, topSelfEnergyFunctionPL, topSelfEnergyFunctionPR,
             topTwoLoop = False, thirdGenMass, qcdCorrections = "",
-            qcdOneLoop, qcdTwoLoop, qcdThreeLoop, qcdFourLoop
+            qcdOneLoop, qcdTwoLoop, qcdThreeLoop, qcdFourLoop,
+            selfEnergies, diagonalization
            },
            dim = GetDimension[particle];
            dimStr = ToString[dim];
@@ -647,65 +664,60 @@ DoMediumDiagonalization[particle_Symbol /; IsFermion[particle], inputMomentum_,
            selfEnergyFunctionPL = SelfEnergies`CreateSelfEnergyFunctionName[particle[PL], 1];
            selfEnergyFunctionPR = SelfEnergies`CreateSelfEnergyFunctionName[particle[PR], 1];
            If[dim > 1,
-              result = qcdCorrections <>
-                       "const " <> selfEnergyMatrixCType <> " M_tree(" <> massMatrixStr <> "());\n" <>
-                       "for (int es = 0; es < " <> dimStr <> "; ++es) {\n" <>
-                       IndentText["const double p = Abs(" <> momentum <> "(es));\n" <>
-                                  If[topTwoLoop,
-                                     selfEnergyMatrixCType <> " self_energy_1;\n" <>
-                                     selfEnergyMatrixCType <> " self_energy_PL;\n" <>
-                                     selfEnergyMatrixCType <> " self_energy_PR;\n" <>
-                                     "for (int i1 = 0; i1 < " <> dimStr <>"; ++i1) {\n" <>
-                                     IndentText["for (int i2 = 0; i2 < " <> dimStr <>"; ++i2) {\n" <>
-                                                IndentText[
-                                                    "if (i1 == 2 && i2 == 2) {\n" <>
-                                                    IndentText["self_energy_1(i1,i2)  = " <> CastIfReal[topSelfEnergyFunctionS <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n" <>
-                                                               "self_energy_PL(i1,i2) = " <> CastIfReal[topSelfEnergyFunctionPL <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n" <>
-                                                               "self_energy_PR(i1,i2) = " <> CastIfReal[topSelfEnergyFunctionPR <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n"] <>
-                                                    "} else {\n" <>
-                                                    IndentText["self_energy_1(i1,i2)  = " <> CastIfReal[selfEnergyFunctionS <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n" <>
-                                                               "self_energy_PL(i1,i2) = " <> CastIfReal[selfEnergyFunctionPL <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n" <>
-                                                               "self_energy_PR(i1,i2) = " <> CastIfReal[selfEnergyFunctionPR <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n"] <>
-                                                    "}\n"
-                                                ] <>
-                                                "}\n"
-                                     ] <>
-                                     "}\n"
-                                     ,
-                                     "const " <> selfEnergyMatrixCType <> " self_energy_1  = " <> CastIfReal[selfEnergyFunctionS  <> "(p)", selfEnergyMatrixType] <> ";\n" <>
-                                     "const " <> selfEnergyMatrixCType <> " self_energy_PL = " <> CastIfReal[selfEnergyFunctionPL <> "(p)", selfEnergyMatrixType] <> ";\n" <>
-                                     "const " <> selfEnergyMatrixCType <> " self_energy_PR = " <> CastIfReal[selfEnergyFunctionPR <> "(p)", selfEnergyMatrixType] <> ";\n"
-                                    ] <>
-                                  If[topTwoLoop,
-                                     selfEnergyMatrixCType <> " delta_M(- self_energy_PR * M_tree " <>
-                                     "- M_tree * self_energy_PL - self_energy_1);\n" <>
-                                     "delta_M(2,2) -= M_tree(2,2) * (qcd_1l + qcd_2l + qcd_3l + qcd_4l);\n"
-                                     ,
-                                     "const " <> selfEnergyMatrixCType <> " delta_M(- self_energy_PR * M_tree " <>
-                                     "- M_tree * self_energy_PL - self_energy_1);\n"
-                                    ]
-                                 ];
+              selfEnergies = "const double p = Abs(" <> momentum <> "(es));\n" <>
+                             If[topTwoLoop,
+                                selfEnergyMatrixCType <> " self_energy_1;\n" <>
+                                selfEnergyMatrixCType <> " self_energy_PL;\n" <>
+                                selfEnergyMatrixCType <> " self_energy_PR;\n" <>
+                                "for (int i1 = 0; i1 < " <> dimStr <>"; ++i1) {\n" <>
+                                IndentText["for (int i2 = 0; i2 < " <> dimStr <>"; ++i2) {\n" <>
+                                           IndentText[
+                                               "if (i1 == 2 && i2 == 2) {\n" <>
+                                               IndentText["self_energy_1(i1,i2)  = " <> CastIfReal[topSelfEnergyFunctionS <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n" <>
+                                                          "self_energy_PL(i1,i2) = " <> CastIfReal[topSelfEnergyFunctionPL <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n" <>
+                                                          "self_energy_PR(i1,i2) = " <> CastIfReal[topSelfEnergyFunctionPR <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n"] <>
+                                               "} else {\n" <>
+                                               IndentText["self_energy_1(i1,i2)  = " <> CastIfReal[selfEnergyFunctionS <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n" <>
+                                                          "self_energy_PL(i1,i2) = " <> CastIfReal[selfEnergyFunctionPL <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n" <>
+                                                          "self_energy_PR(i1,i2) = " <> CastIfReal[selfEnergyFunctionPR <> "(p,i1,i2)", selfEnergyMatrixType] <> ";\n"] <>
+                                               "}\n"
+                                           ] <>
+                                           "}\n"
+                                ] <>
+                                "}\n"
+                                ,
+                                "const " <> selfEnergyMatrixCType <> " self_energy_1  = " <> CastIfReal[selfEnergyFunctionS  <> "(p)", selfEnergyMatrixType] <> ";\n" <>
+                                "const " <> selfEnergyMatrixCType <> " self_energy_PL = " <> CastIfReal[selfEnergyFunctionPL <> "(p)", selfEnergyMatrixType] <> ";\n" <>
+                                "const " <> selfEnergyMatrixCType <> " self_energy_PR = " <> CastIfReal[selfEnergyFunctionPR <> "(p)", selfEnergyMatrixType] <> ";\n"
+                               ] <>
+                             If[topTwoLoop,
+                                selfEnergyMatrixCType <> " delta_M(- self_energy_PR * M_tree " <>
+                                "- M_tree * self_energy_PL - self_energy_1);\n" <>
+                                "delta_M(2,2) -= M_tree(2,2) * (qcd_1l + qcd_2l + qcd_3l + qcd_4l);\n"
+                                ,
+                                "const " <> selfEnergyMatrixCType <> " delta_M(- self_energy_PR * M_tree " <>
+                                "- M_tree * self_energy_PL - self_energy_1);\n"
+                               ];
               If[IsMajoranaFermion[particle],
-                 result = result <>
-                          IndentText["const " <> selfEnergyMatrixCType <> " M_loop(M_tree + 0.5 * (delta_M + delta_M.transpose()));\n"];
+                 selfEnergies = selfEnergies <>
+                                "const " <> selfEnergyMatrixCType <> " M_loop(M_tree + 0.5 * (delta_M + delta_M.transpose()));\n";
                  ,
-                 result = result <>
-                          IndentText["const " <> selfEnergyMatrixCType <> " M_loop(M_tree + delta_M);\n"];
+                 selfEnergies = selfEnergies <>
+                                "const " <> selfEnergyMatrixCType <> " M_loop(M_tree + delta_M);\n";
                 ];
-              result = result <>
-                       IndentText[eigenArrayType <> " eigen_values;\n"];
+              diagonalization = IndentText[eigenArrayType <> " eigen_values;\n"];
               If[Head[mixingMatrix] === List,
                  (* two mixing matrixs => SVD *)
                  U = ToValidCSymbolString[mixingMatrix[[1]]];
                  V = ToValidCSymbolString[mixingMatrix[[2]]];
-                 result = result <>
+                 diagonalization = diagonalization <>
                           IndentText["decltype(" <> U <> ") mix_" <> U <> ";\n" <>
                                      "decltype(" <> V <> ") mix_" <> V <> ";\n"];
-                 result = result <>
+                 diagonalization = diagonalization <>
                           TreeMasses`CallSVDFunction[
                               particle, "M_loop", "eigen_values",
                               "mix_" <> U, "mix_" <> V];
-                 result = result <>
+                 diagonalization = diagonalization <>
                           IndentText["if (es == 0) {\n" <>
                                      IndentText["PHYSICAL(" <> U <> ") = mix_" <> U <> ";\n" <>
                                                 "PHYSICAL(" <> V <> ") = mix_" <> V <> ";\n"] <>
@@ -714,7 +726,7 @@ DoMediumDiagonalization[particle_Symbol /; IsFermion[particle], inputMomentum_,
                  ,
                  U = ToValidCSymbolString[mixingMatrix];
                  If[mixingMatrix =!= Null,
-                    result = result <>
+                    diagonalization = diagonalization <>
                              IndentText["decltype(" <> U <> ") mix_" <> U <> ";\n" <>
                                         TreeMasses`CallDiagonalizeSymmetricFunction[
                                             particle, "M_loop", "eigen_values",
@@ -724,17 +736,20 @@ DoMediumDiagonalization[particle_Symbol /; IsFermion[particle], inputMomentum_,
                                        ];
                     ,
                     mixingMatrixType = CreateCType[CConversion`MatrixType[CConversion`complexScalarCType, dim, dim]];
-                    result = result <>
+                    diagonalization = diagonalization <>
                              IndentText[mixingMatrixType <> " mix_" <> U <> ";\n" <>
                                         TreeMasses`CallDiagonalizeSymmetricFunction[
                                             particle, "M_loop", "eigen_values",
                                             "mix_" <> U]];
                    ];
                 ];
-              result = result <>
+              diagonalization = diagonalization <>
                        IndentText["PHYSICAL(" <> massName <>
                                   "(es)) = Abs(eigen_values(es));\n"];
-              result = result <> "}\n";
+              result = qcdCorrections <>
+                       "const " <> selfEnergyMatrixCType <> " M_tree(" <> massMatrixStr <> "());\n" <>
+                       CalculateLoopMassMatrices[dimStr, selfEnergyMatrixCType, selfEnergies] <>
+                       DiagonalizeLoopMassMatrices[dimStr, selfEnergyMatrixCType, diagonalization];
               ,
               (* for a dimension 1 fermion it plays not role if it's a
                  Majorana fermion or not *)
@@ -995,10 +1010,9 @@ CreateOneLoopPoleMassPrototypes[states_:FlexibleSUSY`FSEigenstates] :=
            Return[result];
           ];
 
-CallThreadedPoleMassFunction[particle_Symbol, ptr_:"this", pool_:"tp"] :=
-    pool <> ".run_task([" <> ptr <> "] () { " <>
-    If[ptr === "this", "", ptr <> "->"] <>
-    CreateLoopMassFunctionName[particle] <> "(); });\n";
+CallThreadedPoleMassFunction[particle_Symbol] :=
+    "pole_mass_functions.push_back(&CLASSNAME::" <>
+    CreateLoopMassFunctionName[particle] <> ");\n";
 
 CallAllPoleMassFunctions[states_, enablePoleMassThreads_] :=
     Module[{particles, susyParticles, smParticles, callSusy,
@@ -1018,13 +1032,21 @@ CallAllPoleMassFunctions[states_, enablePoleMassThreads_] :=
               ,
               callSusy = StringJoin[CallThreadedPoleMassFunction /@ susyParticles];
               callSM   = StringJoin[CallThreadedPoleMassFunction /@ smParticles];
-              result = "Thread_pool tp(std::min(std::thread::hardware_concurrency(), " <> ToString[Length[susyParticles] + Length[smParticles]] <> "u));\n\n" <>
+              (* the tasks use the loop library context of the calling thread *)
+              result = "std::vector<void (CLASSNAME::*)()> pole_mass_functions;\n\n" <>
                        "if (calculate_bsm_pole_masses) {\n" <>
                        IndentText[callSusy] <>
                        "}\n\n" <>
                        "if (calculate_sm_pole_masses) {\n" <>
                        IndentText[callSM] <>
-                       "}\n";
+                       "}\n\n" <>
+                       "Loop_library_context* loop_library_context = Loop_library::get_context();\n\n" <>
+                       "global_thread_pool().parallel_for(\n" <>
+                       IndentText["0, pole_mass_functions.size(),\n" <>
+                                  "[this, &pole_mass_functions, loop_library_context] (std::size_t i) {\n" <>
+                                  IndentText["Loop_library_context_guard guard(loop_library_context);\n" <>
+                                             "(this->*pole_mass_functions[i])();\n"] <>
+                                  "}, 1);\n"];
              ];
            result
           ];
@@ -43,6 +43,10 @@ given list of vertices";
 CreateNPointFunctions::usage="creates C/C++ functions for the
 given list of self-energies and tadpoles";
 
+CreateCouplingCache::usage="creates the members of the coupling cache
+and the C/C++ code to fill and clear the cache for the couplings that
+appear in the given list of self-energies and tadpoles";
+
 CreateSelfEnergyFunctionName::usage="creates self-energy function name
 for a given field";
 
@@ -317,6 +321,31 @@ indexCount = 0;
 MakeUniqueIdx[] :=
     Symbol["id" <> ToString[indexCount++]];
 
+ToRotatedMultiplet[field_] := If[IsUnrotated[field], ToRotatedField[field], field];
+
+(* returns the dimensions of the field multiplets which belong to the
+ * indices of the coupling or Null if the coupling cannot be stored in
+ * a Coupling_table (e.g. because a field carries more than one index)
+ *)
+GetCouplingIndexDimensions[coupling_] :=
+    Module[{fields, dims},
+           fields = Select[GetParticleList[coupling], !FreeQ[#, List[__]]&];
+           If[!And @@ (MatchQ[Cases[#, List[__], Infinity], {{_}}]& /@ fields),
+              Return[Null];
+             ];
+           dims = TreeMasses`GetDimension[ToRotatedMultiplet[# /. p_[{__}] :> p]]& /@ fields;
+           If[!And @@ ((IntegerQ[#] && # > 0)& /@ dims), Return[Null]];
+           dims
+          ];
+
+IsCacheableCoupling[coupling_] := GetCouplingIndexDimensions[coupling] =!= Null;
+
+GetCouplingType[expr_] :=
+    If[Parameters`IsRealExpression[expr],
+       CConversion`ScalarType[CConversion`realScalarCType],
+       CConversion`ScalarType[CConversion`complexScalarCType]
+      ];
+
 (* creates a C++ function that calculates a coupling
  *
  * Return: {prototypes_String, definitions_String, rules_List}
@@ -330,31 +359,43 @@ MakeUniqueIdx[] :=
  *   CpbarUChaVZChaPR[gO2, gI2],
  *   ...
  * }
+ *
+ * If cached is True, the function returns the value stored in the
+ * coupling cache of the model class while the cache is valid and the
+ * table of the coupling has been filled.
  *)
-CreateCouplingFunction[coupling_, expr_, inModelClass_] :=
+CreateCouplingFunction[coupling_, expr_, inModelClass_, cached_:False] :=
     Module[{symbol, prototype = "", definition = "",
             indices = {}, body = "", cFunctionName = "", i,
-            type, typeStr},
+            type, typeStr, useCache, cacheLookup = ""},
            indices = GetParticleIndicesInCoupling[coupling];
            symbol = CreateCouplingSymbol[coupling];
+           useCache = cached && IsCacheableCoupling[coupling] &&
+                      !Or @@ (IntegerQ /@ indices);
            cFunctionName = ToValidCSymbolString[GetHead[symbol]];
+           If[useCache,
+              cacheLookup = "if (coupling_cache.valid && !coupling_cache." <> cFunctionName <> ".empty()) {\n" <>
+                            IndentText["return coupling_cache." <> cFunctionName <> "(" <>
+                                       Utils`StringJoinWithSeparator[ToValidCSymbolString /@ indices, ", "] <>
+                                       ");\n"] <>
+                            "}\n\n";
+             ];
            cFunctionName = cFunctionName <> "(";
            For[i = 1, i <= Length[indices], i++,
                If[i > 1, cFunctionName = cFunctionName <> ", ";];
                cFunctionName = cFunctionName <> "int ";
                (* variable names must not be integers *)
-               If[!IntegerQ[indices[[i]]] && !FreeQ[expr, indices[[i]]],
+               If[!IntegerQ[indices[[i]]] && (useCache || !FreeQ[expr, indices[[i]]]),
                   cFunctionName = cFunctionName <> ToValidCSymbolString[indices[[i]]];
                  ];
               ];
            cFunctionName = cFunctionName <> ")";
-           If[Parameters`IsRealExpression[expr],
-              type = CConversion`ScalarType[CConversion`realScalarCType];,
-              type = CConversion`ScalarType[CConversion`complexScalarCType];];
+           type = GetCouplingType[expr];
            typeStr = CConversion`CreateCType[type];
            prototype = typeStr <> " " <> cFunctionName <> " const;\n";
            definition = typeStr <> " CLASSNAME::" <> cFunctionName <> " const\n{\n";
-           body = If[inModelClass,
+           body = cacheLookup <>
+                  If[inModelClass,
                      Parameters`CreateLocalConstRefsForInputParameters[expr, "LOCALINPUT"],
                      Parameters`CreateLocalConstRefs[expr]
                     ] <> "\n" <>
@@ -399,7 +440,7 @@ ReplaceUnrotatedFields[SARAH`Cp[p__]] :=
 ReplaceUnrotatedFields[SARAH`Cp[p__][lorentz_]] :=
     ReplaceUnrotatedFields[Cp[p]][lorentz];
 
-CreateVertexExpressions[vertexRules_List, inModelClass_:True] :=
+CreateVertexExpressions[vertexRules_List, inModelClass_:True, cached_:False] :=
     Module[{k, prototypes = "", defs = "", rules, coupling, expr,
             p, d, r, MakeIndex},
            MakeIndex[i_Integer] := MakeUniqueIdx[];
@@ -410,7 +451,7 @@ CreateVertexExpressions[vertexRules_List, inModelClass_:True] :=
                coupling = Vertices`ToCp[vertexRules[[k,1]]] /. p_[{idx__}] :> p[MakeIndex /@ {idx}];
                expr = vertexRules[[k,2]];
                Utils`UpdateProgressBar[k, Length[vertexRules]];
-               {p,d,r} = CreateCouplingFunction[coupling, expr, inModelClass];
+               {p,d,r} = CreateCouplingFunction[coupling, expr, inModelClass, cached];
                prototypes = prototypes <> p;
                defs = defs <> d <> "\n";
                rules[[k]] = r;
@@ -587,14 +628,17 @@ CreateNPointFunctionMatrix[nPointFunction_] :=
            { prototype, def }
           ];
 
+(* extract vertex rules needed for the given nPointFunctions *)
+GetRelevantVertexRules[nPointFunctions_List, vertexRules_List] :=
+    Cases[vertexRules, r:(Rule[a_,b_] /; !FreeQ[nPointFunctions,a]) :> r];
+
 CreateNPointFunctions[nPointFunctions_List, vertexRules_List] :=
     Module[{prototypes = "", defs = "", vertexFunctionNames = {}, p, d,
             relevantVertexRules},
            (* create coupling functions for all vertices in the list *)
            Print["Converting vertex functions ..."];
-           (* extract vertex rules needed for the given nPointFunctions *)
-           relevantVertexRules = Cases[vertexRules, r:(Rule[a_,b_] /; !FreeQ[nPointFunctions,a]) :> r];
-           {prototypes, defs, vertexFunctionNames} = CreateVertexExpressions[relevantVertexRules];
+           relevantVertexRules = GetRelevantVertexRules[nPointFunctions, vertexRules];
+           {prototypes, defs, vertexFunctionNames} = CreateVertexExpressions[relevantVertexRules, True, True];
            (* creating n-point functions *)
            Print["Converting self energies ..."];
            Utils`StartProgressBar[Dynamic[k], Length[nPointFunctions]];
@@ -611,6 +655,76 @@ CreateNPointFunctions[nPointFunctions_List, vertexRules_List] :=
            {prototypes, defs}
           ];
 
+(* returns True if the n-point function belongs to the pole mass of a
+ * Standard Model particle
+ *)
+IsSMNPointFunction[nPointFunction_] :=
+    TreeMasses`IsSMParticle[GetHead[GetField[nPointFunction]]];
+
+(* returns the code which fills the tables of the given couplings *)
+FillCouplingTables[names_List] :=
+    StringJoin[("coupling_cache." <> # <>
+                ".fill([this] (auto... i) { return " <> # <> "(i...); });\n")& /@ names];
+
+(* wraps the code in an if-statement, unless it is empty *)
+IfCondition[condition_String, code_String] :=
+    If[code === "", "", "if (" <> condition <> ") {\n" <> IndentText[code] <> "}\n"];
+
+(* creates the members of the coupling cache and the code to fill and
+ * clear the cache
+ *
+ * Return: {members_String, fill_String, clear_String}
+ *
+ * members is a string that contains a Coupling_table for each
+ * coupling which appears in the nPointFunctions, e.g.
+ *
+ *   Coupling_table<std::complex<double>,3,6,6> CpUhhconjSdSd{};
+ *
+ * The tables are filled by calling the coupling functions of the
+ * model class while the cache is invalid.  Couplings, which appear
+ * only in the self-energies of BSM (SM) particles, are filled only if
+ * the BSM (SM) pole masses are calculated.  Couplings in the tadpoles
+ * and in both kinds of self-energies are filled if any pole masses
+ * are calculated.
+ *)
+CreateCouplingCache[nPointFunctions_List, vertexRules_List] :=
+    Module[{members = "", clear = "", coupling, expr, dims,
+            name, typeStr, smNPointFunctions, bsmNPointFunctions,
+            inSM, inBSM, smNames = {}, bsmNames = {}, sharedNames = {}},
+           Print["Creating coupling cache ..."];
+           smNPointFunctions = Select[nPointFunctions,
+                                      (Head[#] =!= SelfEnergies`Tadpole && IsSMNPointFunction[#])&];
+           bsmNPointFunctions = Select[nPointFunctions,
+                                       (Head[#] =!= SelfEnergies`Tadpole && !IsSMNPointFunction[#])&];
+           (
+               coupling = Vertices`ToCp[#[[1]]];
+               expr = #[[2]];
+               If[IsCacheableCoupling[coupling],
+                  dims = GetCouplingIndexDimensions[coupling];
+                  name = ToValidCSymbolString[GetHead[CreateCouplingSymbol[coupling]]];
+                  typeStr = CConversion`CreateCType[GetCouplingType[expr]];
+                  members = members <> "Coupling_table<" <>
+                            Utils`StringJoinWithSeparator[Prepend[ToString /@ dims, typeStr], ","] <>
+                            "> " <> name <> "{};\n";
+                  clear = clear <> "coupling_cache." <> name <> ".clear();\n";
+                  inSM = !FreeQ[smNPointFunctions, #[[1]]];
+                  inBSM = !FreeQ[bsmNPointFunctions, #[[1]]];
+                  Which[inSM && !inBSM, AppendTo[smNames, name],
+                        inBSM && !inSM, AppendTo[bsmNames, name],
+                        True, AppendTo[sharedNames, name]
+                       ];
+                 ];
+           )& /@ GetRelevantVertexRules[nPointFunctions, vertexRules];
+           {members,
+            Utils`StringJoinWithSeparator[
+                DeleteCases[{IfCondition["calculate_bsm_pole_masses", FillCouplingTables[bsmNames]],
+                             IfCondition["calculate_sm_pole_masses", FillCouplingTables[smNames]],
+                             IfCondition["calculate_bsm_pole_masses || calculate_sm_pole_masses",
+                                         FillCouplingTables[sharedNames]]}, ""],
+                "\n"],
+            clear}
+          ];
+
 FillArrayWithLoopTadpoles[loopLevel_, higgsAndIdx_List, arrayName_String, sign_String:"-", struct_String:""] :=
     Module[{body = "", v, field, idx, head, functionName},
            For[v = 1, v <= Length[higgsAndIdx], v++,
@@ -73,6 +73,11 @@ calculates the mass eigenstates by diagonalizing the mass matrix";
 CallMassCalculationFunctions::usage="creates C function calls of all
 mass matrix calcualtion functions";
 
+CallEWSBDependentMassCalculationFunctions::usage="creates C function
+calls of the mass matrix calculation functions, whose mass matrix
+depends on one of the given parameters or on the mixing matrix of such
+a mass matrix";
+
 CreatePhysicalMassDefinition::usage="creates definition of physical
 mass.";
 
@@ -1282,6 +1287,28 @@ CallMassCalculationFunctions[massMatrices_List] :=
            Return[result];
           ];
 
+(* Returns True if the mass matrix m depends on one of the given
+   parameters or mixing matrices. *)
+MassMatrixDependsOn[m_TreeMasses`FSMassMatrix, symbols_List] :=
+    Module[{mm = GetMassMatrix[m] /. Parameters`GetDependenceSPhenoRules[]},
+           Or @@ (!FreeQ[mm, #]& /@ symbols)
+          ];
+
+CallEWSBDependentMassCalculationFunctions[massMatrices_List, parameters_List] :=
+    Module[{dependent = {}, mixings, new},
+           (* iterate until the mass matrices depending on mixing
+              matrices of dependent mass matrices are included *)
+           While[True,
+                 mixings = Flatten[{GetMixingMatrixSymbol[#]}& /@ dependent] /. Null -> Sequence[];
+                 new = Select[Complement[massMatrices, dependent],
+                              MassMatrixDependsOn[#, Join[parameters, mixings]]&];
+                 If[new === {}, Break[]];
+                 dependent = Join[dependent, new];
+                ];
+           (* keep the order of CallMassCalculationFunctions[] *)
+           CallMassCalculationFunctions[Select[massMatrices, MemberQ[dependent, #]&]]
+          ];
+
 CallMassCalculationFunction[massMatrix_TreeMasses`FSMassMatrix] :=
     Module[{result = "", k, massESSymbol},
            massESSymbol = GetMassEigenstate[massMatrix];
@@ -35,7 +35,9 @@
 #include "config.h"
 #include "loop_libraries/loop_library.hpp"
 #include "raii.hpp"
-#include "thread_pool.hpp"
+#ifdef ENABLE_THREADS
+#include "global_thread_pool.hpp"
+#endif
 #include "functors.hpp"
 #include "ew_input.hpp"
 #include "weinberg_angle.hpp"
@@ -45,6 +47,7 @@
 #include "sm_fourloophiggs.hpp"
 #include "sm_fourloop_as.hpp"
 
+#include <array>
 #include <cmath>
 #include <functional>
 #include <iostream>
@@ -155,6 +158,33 @@ const int Standard_model::numberOfParameters;
 #define HIGGS_3LOOP_CORRECTION_AT_AT_AT    loop_corrections.higgs_at_at_at
 #define HIGGS_4LOOP_CORRECTION_AT_AS_AS_AS loop_corrections.higgs_at_as_as_as
 
+namespace {
+
+/**
+ * Calls f(es) for all eigenstates es = 0, ..., n-1.  If threads are
+ * enabled, the calls are distributed over the global thread pool and
+ * use the loop library context of the calling thread.
+ */
+template <typename F>
+void for_each_eigenstate(int n, F&& f)
+{
+#ifdef ENABLE_THREADS
+   Loop_library_context* loop_library_context = Loop_library::get_context();
+
+   global_thread_pool().parallel_for(
+      0, n, [&f, loop_library_context] (std::size_t es) {
+         Loop_library_context_guard guard(loop_library_context);
+         f(static_cast<int>(es));
+      }, 1);
+#else
+   for (int es = 0; es < n; ++es) {
+      f(es);
+   }
+#endif
+}
+
+} // anonymous namespace
+
 Standard_model::Standard_model()
 {
    set_number_of_parameters(numberOfParameters);
@@ -603,17 +633,26 @@ void Standard_model::calculate_DRbar_masses()
 void Standard_model::calculate_pole_masses()
 {
 #ifdef ENABLE_THREADS
-   Thread_pool tp(std::min(std::thread::hardware_concurrency(), 9u));
-
-   tp.run_task([this] () { calculate_MVG_pole(); });
-   tp.run_task([this] () { calculate_MFv_pole(); });
-   tp.run_task([this] () { calculate_Mhh_pole(); });
-   tp.run_task([this] () { calculate_MVP_pole(); });
-   tp.run_task([this] () { calculate_MVZ_pole(); });
-   tp.run_task([this] () { calculate_MFd_pole(); });
-   tp.run_task([this] () { calculate_MFu_pole(); });
-   tp.run_task([this] () { calculate_MFe_pole(); });
-   tp.run_task([this] () { calculate_MVWp_pole(); });
+   const std::array<void (Standard_model::*)(), 9> pole_mass_functions = {
+      &Standard_model::calculate_MVG_pole,
+      &Standard_model::calculate_MFv_pole,
+      &Standard_model::calculate_Mhh_pole,
+      &Standard_model::calculate_MVP_pole,
+      &Standard_model::calculate_MVZ_pole,
+      &Standard_model::calculate_MFd_pole,
+      &Standard_model::calculate_MFu_pole,
+      &Standard_model::calculate_MFe_pole,
+      &Standard_model::calculate_MVWp_pole
+   };
+
+   Loop_library_context* loop_library_context = Loop_library::get_context();
+
+   global_thread_pool().parallel_for(
+      0, pole_mass_functions.size(),
+      [this, &pole_mass_functions, loop_library_context] (std::size_t i) {
+         Loop_library_context_guard guard(loop_library_context);
+         (this->*pole_mass_functions[i])();
+      }, 1);
 
 #else
 
@@ -4547,14 +4586,20 @@ void Standard_model::calculate_MFd_pole()
 {
    // diagonalization with medium precision
    const Eigen::Matrix<double,3,3> M_tree(get_mass_matrix_Fd());
-   for (int es = 0; es < 3; ++es) {
+   std::array<Eigen::Matrix<double,3,3>, 3> M_loop_es;
+
+   for_each_eigenstate(3, [&] (int es) {
       const double p = Abs(MFd(es));
       const Eigen::Matrix<double,3,3> self_energy_1  = Re(self_energy_Fd_1loop_1(p));
       const Eigen::Matrix<double,3,3> self_energy_PL = Re(self_energy_Fd_1loop_PL(p));
       const Eigen::Matrix<double,3,3> self_energy_PR = Re(self_energy_Fd_1loop_PR(p));
       const Eigen::Matrix<double,3,3> delta_M(- self_energy_PR *
          M_tree - M_tree * self_energy_PL - self_energy_1);
-      const Eigen::Matrix<double,3,3> M_1loop(M_tree + delta_M);
+      M_loop_es[es] = M_tree + delta_M;
+   });
+
+   for (int es = 0; es < 3; ++es) {
+      const Eigen::Matrix<double,3,3>& M_1loop = M_loop_es[es];
       Eigen::Array<double,3,1> eigen_values;
       decltype(Vd) mix_Vd;
       decltype(Ud) mix_Ud;
@@ -4615,12 +4660,14 @@ void Standard_model::calculate_MFu_pole()
          currentScale))));
    }
 
-   Eigen::Matrix<double,3,3> self_energy_1;
-   Eigen::Matrix<double,3,3> self_energy_PL;
-   Eigen::Matrix<double,3,3> self_energy_PR;
    const Eigen::Matrix<double,3,3> M_tree(get_mass_matrix_Fu());
-   for (int es = 0; es < 3; ++es) {
+   std::array<Eigen::Matrix<double,3,3>, 3> M_loop_es;
+
+   for_each_eigenstate(3, [&] (int es) {
       const double p = Abs(MFu(es));
+      Eigen::Matrix<double,3,3> self_energy_1;
+      Eigen::Matrix<double,3,3> self_energy_PL;
+      Eigen::Matrix<double,3,3> self_energy_PR;
       for (int i1 = 0; i1 < 3; ++i1) {
          for (int i2 = 0; i2 < 3; ++i2) {
             if (i1 == 2 && i2 == 2) {
@@ -4643,7 +4690,11 @@ void Standard_model::calculate_MFu_pole()
       Eigen::Matrix<double,3,3> delta_M(- self_energy_PR * M_tree -
          M_tree * self_energy_PL - self_energy_1);
       delta_M(2,2) -= M_tree(2,2) * (qcd_1l + qcd_2l + qcd_3l + qcd_4l);
-      const Eigen::Matrix<double,3,3> M_loop(M_tree + delta_M);
+      M_loop_es[es] = M_tree + delta_M;
+   });
+
+   for (int es = 0; es < 3; ++es) {
+      const Eigen::Matrix<double,3,3>& M_loop = M_loop_es[es];
       Eigen::Array<double,3,1> eigen_values;
       decltype(Vu) mix_Vu;
       decltype(Uu) mix_Uu;
@@ -4667,14 +4718,20 @@ void Standard_model::calculate_MFe_pole()
 {
    // diagonalization with medium precision
    const Eigen::Matrix<double,3,3> M_tree(get_mass_matrix_Fe());
-   for (int es = 0; es < 3; ++es) {
+   std::array<Eigen::Matrix<double,3,3>, 3> M_loop_es;
+
+   for_each_eigenstate(3, [&] (int es) {
       const double p = Abs(MFe(es));
       const Eigen::Matrix<double,3,3> self_energy_1  = Re(self_energy_Fe_1loop_1(p));
       const Eigen::Matrix<double,3,3> self_energy_PL = Re(self_energy_Fe_1loop_PL(p));
       const Eigen::Matrix<double,3,3> self_energy_PR = Re(self_energy_Fe_1loop_PR(p));
       const Eigen::Matrix<double,3,3> delta_M(- self_energy_PR *
          M_tree - M_tree * self_energy_PL - self_energy_1);
-      const Eigen::Matrix<double,3,3> M_1loop(M_tree + delta_M);
+      M_loop_es[es] = M_tree + delta_M;
+   });
+
+   for (int es = 0; es < 3; ++es) {
+      const Eigen::Matrix<double,3,3>& M_1loop = M_loop_es[es];
       Eigen::Array<double,3,1> eigen_values;
       decltype(Ve) mix_Ve;
       decltype(Ue) mix_Ue;
@@ -257,4 +257,20 @@ std::complex<long double> Li4(const std::complex<long double>& z_) noexcept
    return rest + sgn*u*horner(u, bf);
 }
 
+/**
+ * @brief Complex polylogarithm \f$\mathrm{Li}_4(z)\f$ of n arguments
+ * @param z array of n complex arguments
+ * @param result array of n results
+ * @param n number of arguments
+ *
+ * Convenience wrapper, which calls the scalar version for each
+ * argument.
+ */
+void Li4(const std::complex<double>* z, std::complex<double>* result, std::size_t n) noexcept
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      result[i] = Li4(z[i]);
+   }
+}
+
 } // namespace flexiblesusy
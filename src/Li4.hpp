@@ -20,6 +20,7 @@
 #define FS_LI4_H
 
 #include <complex>
+#include <cstddef>
 
 namespace flexiblesusy {
 
@@ -29,6 +30,9 @@ std::complex<double> Li4(const std::complex<double>&) noexcept;
 /// complex polylogarithm with n=4 with long double precision
 std::complex<long double> Li4(const std::complex<long double>&) noexcept;
 
+/// complex polylogarithm of order 4 of n arguments
+void Li4(const std::complex<double>*, std::complex<double>*, std::size_t) noexcept;
+
 } // namespace flexiblesusy
 
 #endif
@@ -22,16 +22,23 @@
  */
 
 #include "betafunction.hpp"
-#include "basic_rk_integrator.hpp"
 #include "error.hpp"
+#include "profiling.hpp"
+#include "rg_trajectory.hpp"
+#include "rk.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace flexiblesusy {
 
+constexpr int Beta_function::max_steps;
+
 namespace {
 
-const auto integrator = runge_kutta::Basic_rk_integrator<Eigen::ArrayXd>();
+/// maximum distance of the nodes of a recorded RG trajectory in log(scale)
+constexpr double max_node_distance = 2.;
 
 } // anonymous namespace
 
@@ -55,6 +62,7 @@ void Beta_function::reset()
  */
 void Beta_function::run_to(double x2, double eps)
 {
+   PROFILE_SCOPE("Beta_function::run_to");
    const double tol = get_tolerance(eps);
    run(scale, x2, tol);
 }
@@ -78,13 +86,20 @@ void Beta_function::run(double x1, double x2, double eps)
          throw NonPerturbativeRunningError(x2);
 
       if (fabs(x1 - x2) >= min_tolerance) {
-         Eigen::ArrayXd y(get());
+         Eigen::ArrayXd& y = workspace.ystart;
+         y.resize(get_number_of_parameters());
+         get_into(y);
          const double start = std::log(fabs(x1));
          const double end = std::log(fabs(x2));
+         const double guess = (start - end) * 0.1; // first step size
+         const double hmin = (start - end) * tol * 1.0e-5;
 
-         integrator(start, end, y,
-                    [this](double x, const Eigen::ArrayXd& y) { return derivatives(x, y); },
-                    tol);
+         runge_kutta::integrateOdesInPlace(
+            y, start, end, tol, guess, hmin,
+            [this](double x, const Eigen::ArrayXd& y, Eigen::ArrayXd& dydx) {
+               derivatives(x, y, dydx);
+            },
+            workspace, max_steps);
 
          set_scale(x2);
          set(y);
@@ -94,22 +109,114 @@ void Beta_function::run(double x1, double x2, double eps)
    set_scale(x2);
 }
 
+/**
+ * Runs parameter objects of the generated models from the current
+ * scale to the scale x2 and records the RG flow in the given
+ * trajectory.  The parameters at any scale between the current scale
+ * and x2 can afterwards be obtained from the trajectory without
+ * re-running.
+ *
+ * At each Runge-Kutta step the derivatives of the beta functions
+ * along the flow are determined by a central difference with two
+ * additional beta function evaluations.
+ *
+ * If the running fails, the trajectory contains the flow up to the
+ * last successful Runge-Kutta step and the exception is rethrown.
+ * The parameters of the model are left unchanged in this case.
+ *
+ * @param x2 renormalization scale to run parameters to
+ * @param trajectory RG trajectory (previous content is deleted)
+ * @param eps RG running precision
+ */
+void Beta_function::run_and_record(double x2, RG_trajectory& trajectory, double eps)
+{
+   const double x1 = scale;
+   const double tol = get_tolerance(eps);
+
+   trajectory.clear();
+
+   if (std::fabs(x1) < tol)
+      throw NonPerturbativeRunningError(x1);
+   if (std::fabs(x2) < tol)
+      throw NonPerturbativeRunningError(x2);
+
+   Eigen::ArrayXd& y = workspace.ystart;
+   y.resize(get_number_of_parameters());
+   get_into(y);
+   const double start = std::log(fabs(x1));
+   const double end = std::log(fabs(x2));
+
+   if (get_loops() <= 0 || fabs(x1 - x2) < min_tolerance) {
+      // parameters do not run
+      const Eigen::ArrayXd zero(Eigen::ArrayXd::Zero(y.size()));
+      trajectory.add(start, y, zero, zero);
+      trajectory.add(end, y, zero, zero);
+      set_scale(x2);
+      return;
+   }
+
+   // step size for d^2y/dt^2, relative to t = log(scale)
+   const double delta_rel = std::cbrt(std::numeric_limits<double>::epsilon());
+   Eigen::ArrayXd y_shifted(y.size()), dydx_up(y.size()), dydx_down(y.size());
+
+   const auto record = [&](double x, const Eigen::ArrayXd& y, const Eigen::ArrayXd& dydx) {
+      // make the step exactly representable
+      volatile const double x_up = x + delta_rel * std::max(1.0, std::fabs(x));
+      const double delta = x_up - x;
+      y_shifted = y + delta * dydx;
+      derivatives(x + delta, y_shifted, dydx_up);
+      y_shifted = y - delta * dydx;
+      derivatives(x - delta, y_shifted, dydx_down);
+      trajectory.add(x, y, dydx, (dydx_up - dydx_down) / (2 * delta));
+   };
+
+   // limit the distance between the nodes to keep the interpolation
+   // error below the RG running precision
+   const int segments = static_cast<int>(
+      std::ceil(std::fabs(end - start) / max_node_distance));
+
+   const Eigen::ArrayXd y_start(y);
+
+   try {
+      for (int i = 0; i < segments; i++) {
+         const double from = start + i * (end - start) / segments;
+         const double to = start + (i + 1) * (end - start) / segments;
+         const double guess = (from - to) * 0.1; // first step size
+         const double hmin = (from - to) * tol * 1.0e-5;
+
+         runge_kutta::integrateOdesInPlace(
+            y, from, to, tol, guess, hmin,
+            [this](double x, const Eigen::ArrayXd& y, Eigen::ArrayXd& dydx) {
+               derivatives(x, y, dydx);
+            },
+            workspace, max_steps, record);
+      }
+   } catch (...) {
+      // restore the parameters, the trajectory is kept
+      set_scale(x1);
+      set(y_start);
+      throw;
+   }
+
+   set_scale(x2);
+   set(y);
+}
+
 /**
  * Takes logarithm of renormalisation scale as first argument and
  * parameters of RGE passed in as an Eigen::ArrayXd object of dynamic
- * size in the second argument.  Returns the beta functions as an
- * Eigen::ArrayXd object.
+ * size in the second argument.  Writes the beta functions into the
+ * third argument.
  *
  * @param x logarithm of renormalization scale to calculate beta functions at
  * @param y array of model parameters
- *
- * @return array of beta functions
+ * @param dydx array of beta functions
  */
-Eigen::ArrayXd Beta_function::derivatives(double x, const Eigen::ArrayXd& y)
+void Beta_function::derivatives(double x, const Eigen::ArrayXd& y, Eigen::ArrayXd& dydx)
 {
    set_scale(exp(x));
    set(y);
-   return beta();
+   beta_into(dydx);
 }
 
 /**
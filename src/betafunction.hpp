@@ -24,10 +24,16 @@
 #ifndef BETAFUNCTION_H
 #define BETAFUNCTION_H
 
+#include "error.hpp"
+#include "rk.hpp"
+
+#include <cmath>
 #include <Eigen/Core>
 
 namespace flexiblesusy {
 
+class RG_trajectory;
+
 /**
  * @class Beta_function
  * @brief beta function interface
@@ -37,6 +43,20 @@ namespace flexiblesusy {
  * basic RG running interface.  The run() and run_to() functions use
  * the Runge-Kutta algorithm to integrate the RGEs up to a given
  * scale.
+ *
+ * The RG running is performed without heap allocations once the
+ * internal Runge-Kutta workspace has been sized for the number of
+ * parameters.  For this to be fully allocation-free, derived classes
+ * should override get_into() and beta_into(), which write into
+ * preallocated arrays.
+ *
+ * run_and_record() additionally records the RG flow in an
+ * RG_trajectory, from which the parameters at intermediate scales can
+ * be obtained without re-running.
+ *
+ * Derived classes which know their number of parameters at compile
+ * time may use run_fixed_size() in their implementation of run() to
+ * integrate the RGEs with statically sized arrays.
  */
 class Beta_function {
 public:
@@ -65,8 +85,18 @@ public:
    virtual void set(const Eigen::ArrayXd&) = 0;
    virtual Eigen::ArrayXd beta() const = 0;
 
+   /// writes the parameters into pars (of size get_number_of_parameters())
+   virtual void get_into(Eigen::ArrayXd& pars) const { pars = get(); }
+   /// writes the beta functions into dydx (of size get_number_of_parameters())
+   virtual void beta_into(Eigen::ArrayXd& dydx) const { dydx = beta(); }
+
    virtual void run(double, double, double eps = -1.0);
    virtual void run_to(double, double eps = -1.0);
+   void run_and_record(double, RG_trajectory&, double eps = -1.0);
+
+protected:
+   template <typename Model>
+   static void run_fixed_size(Model&, double, double, double);
 
 private:
    int num_pars{0};              ///< number of parameters
@@ -76,11 +106,63 @@ private:
    double tolerance{1.e-4};      ///< running tolerance
    double min_tolerance{1.e-11}; ///< minimum tolerance allowed
    double zero_threshold{1.e-11};///< threshold for treating values as zero
+   static constexpr int max_steps{400}; ///< maximum number of Runge-Kutta steps
+   runge_kutta::Workspace<Eigen::ArrayXd> workspace{}; ///< Runge-Kutta buffers
 
-   Eigen::ArrayXd derivatives(double, const Eigen::ArrayXd&);
+   void derivatives(double, const Eigen::ArrayXd&, Eigen::ArrayXd&);
    double get_tolerance(double eps) const;
 };
 
+/**
+ * Runs the parameters of the model from scale x1 to scale x2 using
+ * the statically sized interface of the model.  The model must
+ * provide the type Parameters_array (a fixed-size Eigen::Array) and
+ * the functions get_fixed(), set_fixed() and beta_fixed().
+ *
+ * @param model model to run
+ * @param x1 renormalization scale to start RG running from
+ * @param x2 renormalization scale to run parameters to
+ * @param eps RG running precision
+ */
+template <typename Model>
+void Beta_function::run_fixed_size(Model& model, double x1, double x2, double eps)
+{
+   using Array_t = typename Model::Parameters_array;
+   Beta_function& base = model;
+
+   if (base.get_loops() > 0) {
+      const double tol = base.get_tolerance(eps);
+
+      if (std::fabs(x1) < tol)
+         throw NonPerturbativeRunningError(x1);
+      if (std::fabs(x2) < tol)
+         throw NonPerturbativeRunningError(x2);
+
+      if (std::fabs(x1 - x2) >= base.min_tolerance) {
+         Array_t y;
+         model.get_fixed(y);
+         const double start = std::log(std::fabs(x1));
+         const double end = std::log(std::fabs(x2));
+         const double guess = (start - end) * 0.1; // first step size
+         const double hmin = (start - end) * tol * 1.0e-5;
+         runge_kutta::Workspace<Array_t> ws;
+
+         runge_kutta::integrateOdesInPlace(
+            y, start, end, tol, guess, hmin,
+            [&model](double x, const Array_t& p, Array_t& dydx) {
+               model.set_scale(std::exp(x));
+               model.set_fixed(p);
+               model.beta_fixed(dydx);
+            },
+            ws, max_steps);
+
+         model.set_fixed(y);
+      }
+   }
+
+   base.set_scale(x2);
+}
+
 } // namespace flexiblesusy
 
 #endif
@@ -127,6 +127,13 @@ void print_build_info(std::ostream& ostr)
       "yes"
 #else
       "no"
+#endif
+      "\n"
+      "Profiling:                              "
+#ifdef ENABLE_PROFILING
+      "yes"
+#else
+      "no"
 #endif
       "\n"
       "Silent output:                          "
@@ -0,0 +1,516 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "columnar_file.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace flexiblesusy {
+namespace columnar {
+
+namespace {
+
+const char magic[8] = {'F', 'S', 'C', 'O', 'L', '0', '1', '\0'};
+
+/// size of a header with the given name table size
+std::size_t header_size(std::size_t name_table_size)
+{
+   return sizeof(magic) + 2*sizeof(std::uint64_t) + name_table_size;
+}
+
+/// zero-terminated names, padded with zeros to a multiple of 8 bytes
+std::string make_name_table(const std::vector<std::string>& names)
+{
+   std::string table;
+
+   for (const auto& n: names) {
+      if (n.find('\0') != std::string::npos) {
+         throw SetupError("columnar file: column name must not contain a null character");
+      }
+      table += n;
+      table += '\0';
+   }
+
+   table.resize((table.size() + 7) / 8 * 8, '\0');
+
+   return table;
+}
+
+/// header with the given column names
+std::string make_header(const std::vector<std::string>& names)
+{
+   const std::string table = make_name_table(names);
+   const std::uint64_t number_of_columns = names.size();
+   const std::uint64_t table_size = table.size();
+
+   std::string header(magic, sizeof(magic));
+   header.append(reinterpret_cast<const char*>(&number_of_columns), sizeof(number_of_columns));
+   header.append(reinterpret_cast<const char*>(&table_size), sizeof(table_size));
+   header += table;
+
+   return header;
+}
+
+/// reads up to n bytes at the given position, returns the number of bytes read
+std::size_t read_at(int fd, char* data, std::size_t n, std::size_t pos)
+{
+   std::size_t done = 0;
+
+   while (done < n) {
+      const ssize_t res = ::pread(fd, data + done, n - done, static_cast<off_t>(pos + done));
+      if (res < 0 && errno == EINTR) {
+         continue;
+      }
+      if (res <= 0) {
+         break;
+      }
+      done += static_cast<std::size_t>(res);
+   }
+
+   return done;
+}
+
+/// writes the data at the given position (repeated only for short writes)
+bool write_at(int fd, const std::string& data, std::size_t pos)
+{
+   std::size_t done = 0;
+
+   while (done < data.size()) {
+      const ssize_t res = ::pwrite(fd, data.data() + done, data.size() - done,
+                                   static_cast<off_t>(pos + done));
+      if (res < 0 && errno == EINTR) {
+         continue;
+      }
+      if (res <= 0) {
+         return false;
+      }
+      done += static_cast<std::size_t>(res);
+   }
+
+   return true;
+}
+
+/// exclusive advisory lock on a file, released on destruction
+class File_lock {
+public:
+   File_lock(int fd_, const std::string& file_name) : fd(fd_)
+   {
+      int res = 0;
+      while ((res = ::flock(fd, LOCK_EX)) != 0 && errno == EINTR) {}
+      if (res != 0) {
+         throw SetupError("cannot lock columnar file " + file_name);
+      }
+   }
+   ~File_lock() { ::flock(fd, LOCK_UN); }
+   File_lock(const File_lock&) = delete;
+   File_lock& operator=(const File_lock&) = delete;
+
+private:
+   int fd{-1};
+};
+
+/**
+ * Reads the column names from a header
+ *
+ * @param data pointer to the beginning of the file
+ * @param size size of the file
+ * @param file_name file name (for error messages)
+ * @param names column names
+ *
+ * @return size of the header
+ */
+std::size_t read_header(const char* data, std::size_t size, const std::string& file_name,
+                        std::vector<std::string>& names)
+{
+   std::uint64_t number_of_columns = 0, table_size = 0;
+
+   if (size < header_size(0) || std::memcmp(data, magic, sizeof(magic)) != 0) {
+      throw ReadError("columnar file " + file_name + ": invalid header");
+   }
+
+   std::memcpy(&number_of_columns, data + sizeof(magic), sizeof(number_of_columns));
+   std::memcpy(&table_size, data + sizeof(magic) + sizeof(number_of_columns), sizeof(table_size));
+
+   if (table_size % 8 != 0 || size < header_size(table_size)) {
+      throw ReadError("columnar file " + file_name + ": invalid name table");
+   }
+
+   const char* table = data + header_size(0);
+   const char* table_end = table + table_size;
+
+   names.clear();
+
+   while (names.size() < number_of_columns) {
+      const char* end = std::find(table, table_end, '\0');
+      if (end == table_end) {
+         throw ReadError("columnar file " + file_name + ": invalid name table");
+      }
+      names.emplace_back(table, end);
+      table = end + 1;
+   }
+
+   return header_size(table_size);
+}
+
+} // anonymous namespace
+
+/**
+ * Creates a writer.  If the file exists, its header is read, an
+ * incomplete chunk at the end is removed and the rows are appended.
+ *
+ * @param file_name_ file name
+ * @param rows_per_chunk_ number of rows per chunk
+ */
+Writer::Writer(const std::string& file_name_, std::size_t rows_per_chunk_)
+   : file_name(file_name_)
+   , rows_per_chunk(std::max<std::size_t>(rows_per_chunk_, 1))
+{
+   fd = ::open(file_name.c_str(), O_RDWR);
+
+   if (fd >= 0) {
+      try {
+         const File_lock lock(fd, file_name);
+         sync_with_file();
+      } catch (...) {
+         ::close(fd);
+         fd = -1;
+         throw;
+      }
+   }
+}
+
+Writer::~Writer()
+{
+   try {
+      flush();
+   } catch (const Error& e) {
+      ERROR(e.what_detailed());
+   }
+   if (fd >= 0) {
+      ::close(fd);
+   }
+}
+
+/**
+ * Appends a row.  The names of the columns must be the same for all
+ * rows.
+ *
+ * @param names_ column names
+ * @param values row
+ */
+void Writer::append(const std::vector<std::string>& names_, const Eigen::ArrayXd& values)
+{
+   if (names_.size() != static_cast<std::size_t>(values.size())) {
+      throw SetupError("columnar file " + file_name + ": number of names ("
+                       + std::to_string(names_.size()) + ") and values ("
+                       + std::to_string(values.size()) + ") differ");
+   }
+
+   if (names.empty() && !header_in_file) {
+      names = names_;
+   } else if (names != names_) {
+      throw SetupError("columnar file " + file_name + ": column names differ from"
+                       " the ones in the file");
+   }
+
+   rows.insert(rows.end(), values.data(), values.data() + values.size());
+
+   if (rows.size() >= rows_per_chunk * names.size()) {
+      write_chunk();
+   }
+}
+
+void Writer::flush()
+{
+   if (!rows.empty()) {
+      write_chunk();
+   }
+}
+
+/**
+ * Reads the header of the file (unless it is empty), checks the
+ * column names and removes an incomplete chunk at the end of the
+ * file.  Must be called while the file is locked.
+ *
+ * @return end of the last complete chunk (= size of the file)
+ */
+std::size_t Writer::sync_with_file()
+{
+   struct stat st;
+   if (::fstat(fd, &st) != 0) {
+      throw SetupError("cannot access columnar file " + file_name);
+   }
+
+   const std::size_t size = static_cast<std::size_t>(st.st_size);
+
+   if (size == 0) {
+      header_in_file = false;
+      file_end = 0;
+      return 0;
+   }
+
+   std::string header(header_size(0), '\0');
+   header.resize(read_at(fd, &header[0], header.size(), 0));
+
+   if (header.size() == header_size(0) &&
+       std::memcmp(header.data(), magic, sizeof(magic)) == 0) {
+      // read the name table in addition
+      std::uint64_t table_size = 0;
+      std::memcpy(&table_size, &header[header_size(0) - sizeof(table_size)], sizeof(table_size));
+      if (table_size <= size) {
+         header.resize(header_size(0) + table_size);
+         header.resize(header_size(0) + read_at(fd, &header[header_size(0)], table_size, header_size(0)));
+      }
+   }
+
+   std::vector<std::string> file_names;
+   std::size_t pos = read_header(header.data(), header.size(), file_name, file_names);
+
+   if (names.empty() && !header_in_file) {
+      names = file_names;
+   } else if (names != file_names) {
+      throw SetupError("columnar file " + file_name + ": column names differ from"
+                       " the ones in the file");
+   }
+
+   header_in_file = true;
+
+   // chunks up to file_end have been checked before
+   if (file_end > pos && file_end <= size) {
+      pos = file_end;
+   }
+
+   const std::size_t row_size = names.size()*sizeof(double);
+
+   while (pos + sizeof(std::uint64_t) <= size) {
+      std::uint64_t rows = 0;
+      read_at(fd, reinterpret_cast<char*>(&rows), sizeof(rows), pos);
+      if (row_size > 0 && rows > (size - pos - sizeof(rows)) / row_size) {
+         break;
+      }
+      pos += sizeof(rows) + rows*row_size;
+   }
+
+   if (pos != size) {
+      WARNING("columnar file " << file_name << ": removing incomplete chunk");
+      if (::ftruncate(fd, static_cast<off_t>(pos)) != 0) {
+         throw SetupError("cannot truncate columnar file " + file_name);
+      }
+   }
+
+   file_end = pos;
+
+   return pos;
+}
+
+/**
+ * Writes the collected rows as one chunk (column by column).  The
+ * header (if the file is empty) and the chunk are written with a
+ * single write while the file is locked.
+ */
+void Writer::write_chunk()
+{
+   if (fd < 0) {
+      fd = ::open(file_name.c_str(), O_RDWR | O_CREAT, 0666);
+      if (fd < 0) {
+         throw SetupError("cannot open columnar file " + file_name);
+      }
+   }
+
+   const File_lock lock(fd, file_name);
+   const std::size_t pos = sync_with_file();
+
+   const std::size_t number_of_columns = names.size();
+   const std::uint64_t number_of_rows = number_of_columns > 0 ? rows.size() / number_of_columns : 0;
+
+   std::vector<double> columns(rows.size());
+   for (std::size_t r = 0; r < number_of_rows; r++) {
+      for (std::size_t c = 0; c < number_of_columns; c++) {
+         columns[c*number_of_rows + r] = rows[r*number_of_columns + c];
+      }
+   }
+
+   std::string chunk = header_in_file ? std::string() : make_header(names);
+   chunk.append(reinterpret_cast<const char*>(&number_of_rows), sizeof(number_of_rows));
+   chunk.append(reinterpret_cast<const char*>(columns.data()), columns.size()*sizeof(double));
+
+   if (!write_at(fd, chunk, pos)) {
+      throw SetupError("cannot write to columnar file " + file_name);
+   }
+
+   header_in_file = true;
+   file_end = pos + chunk.size();
+   rows.clear();
+}
+
+/**
+ * Maps the file into memory and reads the header and the chunk
+ * layout.
+ *
+ * @param file_name file name
+ */
+Reader::Reader(const std::string& file_name)
+{
+   const int fd = ::open(file_name.c_str(), O_RDONLY);
+   if (fd < 0) {
+      throw ReadError("cannot open columnar file " + file_name);
+   }
+
+   struct stat st;
+   if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+      ::close(fd);
+      throw ReadError("columnar file " + file_name + " is empty");
+   }
+
+   map_size = static_cast<std::size_t>(st.st_size);
+   map = ::mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   ::close(fd);
+
+   if (map == MAP_FAILED) {
+      map = nullptr;
+      throw ReadError("cannot map columnar file " + file_name);
+   }
+
+   try {
+      const char* data = static_cast<const char*>(map);
+      std::size_t pos = read_header(data, map_size, file_name, names);
+      const std::size_t row_size = names.size()*sizeof(double);
+
+      while (pos + sizeof(std::uint64_t) <= map_size) {
+         std::uint64_t rows = 0;
+         std::memcpy(&rows, data + pos, sizeof(rows));
+         pos += sizeof(rows);
+
+         if (row_size > 0 && rows > (map_size - pos) / row_size) {
+            WARNING("columnar file " << file_name << ": ignoring incomplete chunk");
+            break;
+         }
+
+         Chunk chunk;
+         chunk.first_row = number_of_rows;
+         chunk.rows = static_cast<long long>(rows);
+         chunk.data = reinterpret_cast<const double*>(data + pos);
+         chunks.push_back(chunk);
+
+         number_of_rows += chunk.rows;
+         pos += rows*row_size;
+      }
+   } catch (...) {
+      ::munmap(map, map_size);
+      map = nullptr;
+      throw;
+   }
+}
+
+Reader::~Reader()
+{
+   if (map) {
+      ::munmap(map, map_size);
+   }
+}
+
+long long Reader::find_column(const std::string& name) const
+{
+   const auto it = std::find(names.cbegin(), names.cend(), name);
+   return it == names.cend() ? -1 : static_cast<long long>(it - names.cbegin());
+}
+
+const Reader::Chunk& Reader::find_chunk(long long row) const
+{
+   if (row < 0 || row >= number_of_rows) {
+      throw OutOfBoundsError("columnar file: row " + std::to_string(row)
+                             + " out of range [0, " + std::to_string(number_of_rows) + ")");
+   }
+
+   // first chunk which starts behind the row
+   const auto it = std::upper_bound(
+      chunks.cbegin(), chunks.cend(), row,
+      [] (long long r, const Chunk& c) { return r < c.first_row; });
+
+   return *(it - 1);
+}
+
+double Reader::get(long long row, std::size_t column) const
+{
+   if (column >= names.size()) {
+      throw OutOfBoundsError("columnar file: column " + std::to_string(column)
+                             + " out of range");
+   }
+
+   const Chunk& chunk = find_chunk(row);
+
+   return chunk.data[column*chunk.rows + (row - chunk.first_row)];
+}
+
+/**
+ * Extracts a row.  If the row index is negative, the rows are
+ * counted from the end, i.e. -1 is the last row.
+ *
+ * @param row row index
+ *
+ * @return values of the row
+ */
+Eigen::ArrayXd Reader::get_row(long long row) const
+{
+   if (row < 0) {
+      row += number_of_rows;
+   }
+
+   const Chunk& chunk = find_chunk(row);
+   const long long r = row - chunk.first_row;
+   const std::size_t number_of_columns = names.size();
+
+   Eigen::ArrayXd values(number_of_columns);
+
+   for (std::size_t c = 0; c < number_of_columns; c++) {
+      values(c) = chunk.data[c*chunk.rows + r];
+   }
+
+   return values;
+}
+
+Eigen::ArrayXd Reader::get_column(std::size_t column) const
+{
+   if (column >= names.size()) {
+      throw OutOfBoundsError("columnar file: column " + std::to_string(column)
+                             + " out of range");
+   }
+
+   Eigen::ArrayXd values(number_of_rows);
+
+   for (const auto& chunk: chunks) {
+      values.segment(chunk.first_row, chunk.rows) =
+         Eigen::Map<const Eigen::ArrayXd>(chunk.data + column*chunk.rows, chunk.rows);
+   }
+
+   return values;
+}
+
+} // namespace columnar
+} // namespace flexiblesusy
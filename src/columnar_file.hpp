@@ -0,0 +1,144 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef COLUMNAR_FILE_H
+#define COLUMNAR_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <Eigen/Core>
+
+namespace flexiblesusy {
+namespace columnar {
+
+/**
+ * @file columnar_file.hpp
+ * @brief Binary file with a fixed set of double columns
+ *
+ * The file is self-describing and consists of a header, which
+ * contains the column names, followed by chunks of rows.  Within a
+ * chunk the values are stored column by column.  All numbers are
+ * stored in native byte order and are aligned to 8 bytes, such that
+ * the file can be memory-mapped and the columns of a chunk can be
+ * used in place:
+ *
+ * \verbatim
+   header: "FSCOL01\0"                       8 bytes
+           number of columns N               uint64
+           size of the name table S          uint64
+           N zero-terminated column names,   S bytes
+           padded with zeros to a multiple of 8
+   chunk:  number of rows R                  uint64
+           N columns of R doubles each       8*N*R bytes
+   chunk:  ...
+   \endverbatim
+ */
+
+/**
+ * @class Writer
+ * @brief Appends rows of doubles to a columnar file
+ *
+ * The rows are collected in memory and are written as one chunk
+ * after get_rows_per_chunk() rows, when flush() is called or when
+ * the writer is destroyed.  If the file exists already, the rows are
+ * appended, provided that the column names agree with the ones in
+ * the file.  An incomplete chunk at the end of the file (for example
+ * from an interrupted writer) is removed.
+ *
+ * Each chunk (together with the header, if the file is empty) is
+ * written with a single write while an exclusive advisory lock
+ * (flock) is held on the file.  Thus, several processes can append
+ * to the same file.
+ */
+class Writer {
+public:
+   explicit Writer(const std::string& file_name, std::size_t rows_per_chunk = 1024);
+   Writer(const Writer&) = delete;
+   Writer(Writer&&) = delete;
+   ~Writer();
+
+   /// append a row of doubles
+   void append(const std::vector<std::string>&, const Eigen::ArrayXd&);
+   /// write all collected rows to the file
+   void flush();
+
+   const std::vector<std::string>& get_names() const { return names; }
+   std::size_t get_rows_per_chunk() const { return rows_per_chunk; }
+
+private:
+   std::string file_name{};            ///< file name
+   int fd{-1};                         ///< file descriptor (opened on first write, if file does not exist)
+   std::vector<std::string> names{};   ///< column names
+   std::vector<double> rows{};         ///< collected rows (row-major)
+   std::size_t rows_per_chunk{1024};   ///< number of rows per chunk
+   std::size_t file_end{0};            ///< end of the last complete chunk known to the writer
+   bool header_in_file{false};         ///< file contains header already
+
+   std::size_t sync_with_file();
+   void write_chunk();
+};
+
+/**
+ * @class Reader
+ * @brief Reads a columnar file via a read-only memory mapping
+ *
+ * Incomplete chunks at the end of the file (for example from an
+ * interrupted writer) are ignored.
+ */
+class Reader {
+public:
+   explicit Reader(const std::string& file_name);
+   Reader(const Reader&) = delete;
+   Reader(Reader&&) = delete;
+   ~Reader();
+
+   const std::vector<std::string>& get_names() const { return names; }
+   std::size_t get_number_of_columns() const { return names.size(); }
+   long long get_number_of_rows() const { return number_of_rows; }
+
+   /// index of column with the given name (or -1 if there is no such column)
+   long long find_column(const std::string&) const;
+   /// value in the given row and column
+   double get(long long, std::size_t) const;
+   /// extract a row (negative values count from the end)
+   Eigen::ArrayXd get_row(long long) const;
+   /// extract a column
+   Eigen::ArrayXd get_column(std::size_t) const;
+
+private:
+   /// location of a chunk in the memory mapping
+   struct Chunk {
+      long long first_row{0}; ///< index of the first row
+      long long rows{0};      ///< number of rows
+      const double* data{nullptr}; ///< columns of the chunk
+   };
+
+   void* map{nullptr};               ///< start of memory mapping
+   std::size_t map_size{0};          ///< size of memory mapping
+   std::vector<std::string> names{}; ///< column names
+   std::vector<Chunk> chunks{};      ///< chunks in the file
+   long long number_of_rows{0};      ///< total number of rows
+
+   const Chunk& find_chunk(long long) const;
+};
+
+} // namespace columnar
+} // namespace flexiblesusy
+
+#endif
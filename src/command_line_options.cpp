@@ -62,6 +62,12 @@ void Command_line_options::parse(const Dynamic_array_view<char*>& args)
          database_output_file = option.substr(23);
       } else if (starts_with(option,"--rgflow-output-file=")) {
          rgflow_file = option.substr(21);
+      } else if (starts_with(option,"--columnar-output-file=")) {
+         columnar_output_file = option.substr(23);
+      } else if (starts_with(option,"--columnar-input-file=")) {
+         columnar_input_file = option.substr(22);
+      } else if (starts_with(option,"--columnar-entry=")) {
+         columnar_entry = std::stoll(option.substr(17));
       } else if (option == "--help" || option == "-h") {
          print_usage(std::cout);
          do_exit = true;
@@ -111,6 +117,13 @@ void Command_line_options::print_usage(std::ostream& ostr) const
            "  --database-output-file=<filename> SQLite database file to write\n"
            "                                    parameter point to\n"
            "  --rgflow-output-file=<filename>   file to write rgflow to\n"
+           "  --columnar-output-file=<filename> columnar binary file to append\n"
+           "                                    parameter point to\n"
+           "  --columnar-input-file=<filename>  write a parameter point from a\n"
+           "                                    columnar binary file to the SLHA\n"
+           "                                    output instead of calculating it\n"
+           "  --columnar-entry=<value>          entry of the columnar input file\n"
+           "                                    (default: -1 = last entry)\n"
            "  --build-info                      print build information\n"
            "  --model-info                      print model information\n"
            "  --help,-h                         print this help message\n"
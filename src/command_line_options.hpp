@@ -59,6 +59,9 @@ public:
    void print_version(std::ostream&) const;
    void reset();
 
+   const std::string& get_columnar_input_file() const { return columnar_input_file; }
+   const std::string& get_columnar_output_file() const { return columnar_output_file; }
+   long long get_columnar_entry() const { return columnar_entry; }
    const std::string& get_database_output_file() const { return database_output_file; }
    const std::string& get_slha_input_file() const { return slha_input_file; }
    const std::string& get_slha_output_file() const { return slha_output_file; }
@@ -75,6 +78,9 @@ private:
    bool do_print_model_info{false};
    int exit_status{EXIT_SUCCESS};
    std::string program{};
+   std::string columnar_input_file{};
+   std::string columnar_output_file{};
+   long long columnar_entry{-1};
    std::string database_output_file{};
    std::string rgflow_file{};
    std::string slha_input_file{};
@@ -0,0 +1,132 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef COUPLING_TABLE_H
+#define COUPLING_TABLE_H
+
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+/**
+ * @file coupling_table.hpp
+ * @brief contains a table which stores the values of a coupling for
+ * all combinations of the field indices
+ */
+
+namespace flexiblesusy {
+
+/**
+ * @class Coupling_table
+ * @brief stores the values of a coupling for all index combinations
+ *
+ * The k-th index of the coupling runs from 0 to Dims_k - 1.  The
+ * table is filled by calling a function (usually the coupling
+ * function itself) with all index combinations.  The values are
+ * stored on the heap, such that an empty table is cheap to copy.
+ *
+ * Usage:
+ * @code
+ * Coupling_table<std::complex<double>,3,6> table;
+ * table.fill([&model] (int i, int j) { return model.CpUhhconjSdSd(i, j); });
+ * const auto c = table(1, 4);
+ * @endcode
+ */
+template <typename T, int... Dims>
+class Coupling_table {
+public:
+   static constexpr int number_of_indices = sizeof...(Dims);
+
+   /// fills the table by calling f(i_1, ..., i_n) for all indices
+   template <typename F>
+   void fill(F&& f)
+   {
+      values.resize(size());
+      for (int n = 0; n < size(); n++) {
+         values[n] = call(f, n, std::make_integer_sequence<int, number_of_indices>());
+      }
+   }
+
+   /// removes all values and releases the memory
+   void clear() { std::vector<T>().swap(values); }
+
+   bool empty() const { return values.empty(); }
+
+   /// returns the stored value for the given indices
+   template <typename... Idx>
+   const T& operator()(Idx... idx) const
+   {
+      static_assert(sizeof...(Idx) == number_of_indices,
+                    "wrong number of coupling indices");
+      return values[flat_index({static_cast<int>(idx)...})];
+   }
+
+   /// returns the number of index combinations
+   static constexpr int size()
+   {
+      int n = 1;
+      for (const int d: {Dims..., 1}) {
+         n *= d;
+      }
+      return n;
+   }
+
+private:
+   std::vector<T> values{}; ///< values in column-major order
+
+   static int dimension(int k)
+   {
+      const int dims[] = {Dims..., 1};
+      return dims[k];
+   }
+
+   static int flat_index(std::initializer_list<int> idx)
+   {
+      int n = 0, stride = 1, k = 0;
+      for (const int i: idx) {
+         n += i * stride;
+         stride *= dimension(k++);
+      }
+      return n;
+   }
+
+   /// returns the k-th index of the n-th table entry
+   static int index(int n, int k)
+   {
+      for (int i = 0; i < k; i++) {
+         n /= dimension(i);
+      }
+      return n % dimension(k);
+   }
+
+   template <typename F, int... K>
+   static T call(F& f, int n, std::integer_sequence<int, K...>)
+   {
+      return f(index(n, K)...);
+   }
+
+   template <typename F>
+   static T call(F& f, int, std::integer_sequence<int>)
+   {
+      return f();
+   }
+};
+
+} // namespace flexiblesusy
+
+#endif
@@ -35,23 +35,6 @@
 namespace flexiblesusy {
 namespace database {
 
-namespace {
-
-double to_double(const std::string& str)
-{
-   double d = 0.0;
-
-   try {
-      d = std::stod(str);
-   } catch (std::exception& e) {
-      throw ReadError(e.what());
-   }
-
-   return d;
-}
-
-} // anonymous namespace
-
 class SQLiteReadError : Error {
 public:
    explicit SQLiteReadError(const std::string& msg) : Error(msg) {}
@@ -81,36 +64,39 @@ sqlite3* open(const std::string& file_name)
 }
 
 /**
- * Callback function which fills an Eigen::ArrayXd with the data in
- * the given row.
+ * Fills an Eigen::ArrayXd with the data in the current row of the
+ * given statement.  NULL entries (inserted NaN values) are returned
+ * as NaN.
  *
- * @param data pointer to Eigen::ArrayXd
- * @param argc number of columns
- * @param argv array of column entries
- * @param col_name array of column names
+ * @param stmt statement
  *
- * @return 0
+ * @return values of the row
  */
-int extract_callback(void* data, int argc, char** argv, char** col_name)
+Eigen::ArrayXd extract_row(sqlite3_stmt* stmt)
 {
-   auto values = static_cast<Eigen::ArrayXd*>(data);
-   values->conservativeResize(argc);
-
-   for (int i = 0; i < argc; i++) {
-      (*values)(i) = to_double(argv[i]);
-      VERBOSE_MSG(col_name[i] << " = " << argv[i]);
+   const int number_of_columns = sqlite3_column_count(stmt);
+   Eigen::ArrayXd values(number_of_columns);
+
+   for (int i = 0; i < number_of_columns; i++) {
+      values(i) = sqlite3_column_type(stmt, i) == SQLITE_NULL
+         ? std::numeric_limits<double>::quiet_NaN()
+         : sqlite3_column_double(stmt, i);
+      VERBOSE_MSG(sqlite3_column_name(stmt, i) << " = " << values(i));
    }
 
-   return 0;
+   return values;
 }
 
 Database::Database(const std::string& file_name)
    : db(open(file_name))
 {
+   execute("PRAGMA synchronous = OFF;");
 }
 
 Database::~Database()
 {
+   commit();
+   finalize_insert_statements();
    sqlite3_close(db);
 }
 
@@ -118,6 +104,11 @@ Database::~Database()
  * Insert a row of doubles into a table.  If the table does not exist,
  * it is created.
  *
+ * The INSERT statement is prepared at the first insertion into the
+ * table and re-used as long as the column names do not change.  If
+ * more than one row per transaction is requested, the row is added
+ * to the currently open transaction.
+ *
  * @param table_name name of table
  * @param names vector of column names
  * @param data vector of doubles
@@ -134,28 +125,66 @@ void Database::insert(
       return;
    }
 
-   create_table<double>(table_name, names);
+   sqlite3_stmt* stmt = get_insert_statement(table_name, names);
 
-   std::string sql("INSERT INTO " + table_name + " (");
+   if (!stmt) {
+      return;
+   }
+
+   if (rows_per_transaction > 1 && rows_in_transaction == 0) {
+      execute("BEGIN TRANSACTION;");
+   }
 
    for (std::size_t i = 0; i < number_of_elements; i++) {
-      sql += '"' + names[i] + '"';
-      if (i + 1 != number_of_elements)
-         sql += ',';
+      sqlite3_bind_double(stmt, static_cast<int>(i + 1), data[i]);
    }
 
-   sql += ") VALUES (";
+   const int rc = sqlite3_step(stmt);
 
-   for (std::size_t i = 0; i < number_of_elements; i++) {
-      sql += flexiblesusy::to_string(data[i]);
-      if (i + 1 != number_of_elements)
-         sql += ',';
+   if (rc != SQLITE_DONE) {
+      ERROR("SQL error while inserting into table " << table_name
+            << ": " << sqlite3_errmsg(db));
    }
 
-   sql += ");";
+   sqlite3_reset(stmt);
 
-   execute("PRAGMA synchronous = OFF;");
-   execute(sql);
+   if (rows_per_transaction > 1 && ++rows_in_transaction >= rows_per_transaction) {
+      commit();
+   }
+}
+
+/**
+ * Commit the currently open transaction.  If no transaction is open,
+ * this function does nothing.
+ */
+void Database::commit()
+{
+   if (rows_in_transaction > 0) {
+      rows_in_transaction = 0;
+      execute("COMMIT;");
+   }
+}
+
+/**
+ * Set the number of rows, which are inserted in one transaction.  The
+ * currently open transaction is committed.
+ *
+ * @param rows number of rows per transaction (0 and 1 = commit every
+ * row immediately)
+ */
+void Database::set_rows_per_transaction(std::size_t rows)
+{
+   commit();
+   rows_per_transaction = rows;
+}
+
+/**
+ * Switch the database to write-ahead log journal mode, which allows
+ * other processes to read from the database while it is written.
+ */
+void Database::enable_write_ahead_log()
+{
+   execute("PRAGMA journal_mode = WAL;");
 }
 
 /**
@@ -175,7 +204,21 @@ Eigen::ArrayXd Database::extract(const std::string& table_name, long long row)
        "SELECT * FROM " + table_name + " WHERE ROWID = (SELECT MAX(ROWID) - "
           + flexiblesusy::to_string(std::abs(row + 1)) + " FROM " + table_name + ");");
 
-   execute(sql, extract_callback, static_cast<void*>(&values));
+   sqlite3_stmt* stmt = nullptr;
+   int rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
+
+   if (rc == SQLITE_OK) {
+      rc = sqlite3_step(stmt);
+      if (rc == SQLITE_ROW) {
+         values = extract_row(stmt);
+      }
+   }
+
+   if (rc != SQLITE_ROW && rc != SQLITE_DONE) {
+      ERROR("SQL error while executing command \"" << sql << "\": " << sqlite3_errmsg(db));
+   }
+
+   sqlite3_finalize(stmt);
 
    return values;
 }
@@ -206,34 +249,82 @@ void Database::create_table(
 }
 
 /**
- * Execute a SQL command without a callback.
+ * Returns the prepared INSERT statement for the given table and
+ * column names.  If no such statement exists, the table is created
+ * (if it does not exist) and the statement is prepared.
  *
- * @param cmd command
+ * @param table_name name of table
+ * @param names names of table columns
+ *
+ * @return prepared statement or nullptr on error
  */
-void Database::execute(const std::string& cmd)
+sqlite3_stmt* Database::get_insert_statement(
+   const std::string& table_name, const std::vector<std::string>& names)
 {
-   char* zErrMsg = nullptr;
-   const int rc = sqlite3_exec(db, cmd.c_str(), nullptr, nullptr, &zErrMsg);
+   auto& entry = insert_statements[table_name];
+
+   if (entry.stmt && entry.names == names) {
+      return entry.stmt;
+   }
+
+   sqlite3_finalize(entry.stmt);
+   entry.stmt = nullptr;
+   entry.names = names;
+
+   create_table<double>(table_name, names);
+
+   const std::size_t number_of_elements = names.size();
+   std::string sql("INSERT INTO " + table_name + " (");
+
+   for (std::size_t i = 0; i < number_of_elements; i++) {
+      sql += '"' + names[i] + '"';
+      if (i + 1 != number_of_elements)
+         sql += ',';
+   }
+
+   sql += ") VALUES (";
+
+   for (std::size_t i = 0; i < number_of_elements; i++) {
+      sql += '?';
+      if (i + 1 != number_of_elements)
+         sql += ',';
+   }
+
+   sql += ");";
+
+   const int rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &entry.stmt, nullptr);
 
    if (rc != SQLITE_OK) {
-      ERROR("SQL error while executing command \"" << cmd << "\": " << zErrMsg);
-      sqlite3_free(zErrMsg);
+      ERROR("SQL error while preparing command \"" << sql << "\": " << sqlite3_errmsg(db));
+      sqlite3_finalize(entry.stmt);
+      entry.stmt = nullptr;
    } else {
-      VERBOSE_MSG("SQL command \"" << cmd << "\" executed successfully");
+      VERBOSE_MSG("SQL command \"" << sql << "\" prepared successfully");
+   }
+
+   return entry.stmt;
+}
+
+/**
+ * Destroy all prepared INSERT statements.
+ */
+void Database::finalize_insert_statements()
+{
+   for (auto& entry: insert_statements) {
+      sqlite3_finalize(entry.second.stmt);
    }
+   insert_statements.clear();
 }
 
 /**
- * Execute a SQL command using a callback function.
+ * Execute a SQL command without a callback.
  *
  * @param cmd command
- * @param callback pointer to callback function
- * @param data pointer to data passed to callback function
  */
-void Database::execute(const std::string& cmd, TCallback callback, void* data)
+void Database::execute(const std::string& cmd)
 {
    char* zErrMsg = nullptr;
-   const int rc = sqlite3_exec(db, cmd.c_str(), callback, data, &zErrMsg);
+   const int rc = sqlite3_exec(db, cmd.c_str(), nullptr, nullptr, &zErrMsg);
 
    if (rc != SQLITE_OK) {
       ERROR("SQL error while executing command \"" << cmd << "\": " << zErrMsg);
@@ -277,16 +368,148 @@ Eigen::ArrayXd Database::extract(const std::string&, long long)
    throw DisabledSQLiteError("Cannot call extract(), because SQLite support is disabled.");
 }
 
+void Database::commit() {}
+
+void Database::set_rows_per_transaction(std::size_t rows)
+{
+   rows_per_transaction = rows;
+}
+
+void Database::enable_write_ahead_log() {}
+
 template <typename T>
 void Database::create_table(const std::string&, const std::vector<std::string>&)
 {
 }
 
-void Database::execute(const std::string&) {}
+sqlite3_stmt* Database::get_insert_statement(const std::string&, const std::vector<std::string>&)
+{
+   return nullptr;
+}
 
-void Database::execute(const std::string&, TCallback, void*) {}
+void Database::finalize_insert_statements() {}
+
+void Database::execute(const std::string&) {}
 
 } // namespace database
 } // namespace flexiblesusy
 
 #endif
+
+namespace flexiblesusy {
+namespace database {
+
+/**
+ * Opens the database and starts the writer thread.
+ *
+ * @param file_name database file name
+ * @param rows_per_transaction maximum number of rows per transaction
+ */
+Database_writer::Database_writer(const std::string& file_name, std::size_t rows_per_transaction)
+   : db(file_name)
+{
+   db.set_rows_per_transaction(rows_per_transaction);
+   writer = std::thread(&Database_writer::write_queue, this);
+}
+
+/**
+ * Writes all remaining rows and stops the writer thread.
+ */
+Database_writer::~Database_writer()
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+   }
+   row_queued.notify_one();
+   writer.join();
+
+   if (error) {
+      try {
+         std::rethrow_exception(error);
+      } catch (const std::exception& e) {
+         ERROR("error while writing to database: " << e.what());
+      } catch (...) {
+         ERROR("unknown error while writing to database");
+      }
+   }
+}
+
+/**
+ * Queue a row of doubles for insertion into a table.  This function
+ * may be called concurrently from several threads.
+ *
+ * @param table_name name of table
+ * @param names vector of column names
+ * @param data vector of doubles
+ */
+void Database_writer::insert(
+   std::string table_name, std::vector<std::string> names, Eigen::ArrayXd data)
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.push_back(Row{std::move(table_name), std::move(names), std::move(data)});
+   }
+   row_queued.notify_one();
+}
+
+/**
+ * Wait until all rows, which have been queued so far, are written
+ * and committed.  If an error occurred in the writer thread, it is
+ * re-thrown.
+ */
+void Database_writer::flush()
+{
+   std::unique_lock<std::mutex> lock(mutex);
+   rows_done.wait(lock, [this] { return queue.empty() && rows_in_progress == 0; });
+
+   if (error) {
+      const auto e = error;
+      error = nullptr;
+      std::rethrow_exception(e);
+   }
+}
+
+/**
+ * Function of the writer thread: writes the queued rows until stop
+ * is requested and the queue is empty.
+ */
+void Database_writer::write_queue()
+{
+   std::deque<Row> rows;
+
+   while (true) {
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         row_queued.wait(lock, [this] { return stop || !queue.empty(); });
+         if (queue.empty()) {
+            return;
+         }
+         rows.swap(queue);
+         rows_in_progress = rows.size();
+      }
+
+      try {
+         for (const auto& row: rows) {
+            db.insert(row.table, row.names, row.data);
+         }
+         db.commit();
+      } catch (...) {
+         std::lock_guard<std::mutex> lock(mutex);
+         if (!error) {
+            error = std::current_exception();
+         }
+      }
+
+      rows.clear();
+
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         rows_in_progress = 0;
+      }
+      rows_done.notify_all();
+   }
+}
+
+} // namespace database
+} // namespace flexiblesusy
@@ -16,15 +16,34 @@
 // <http://www.gnu.org/licenses/>.
 // ====================================================================
 
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <Eigen/Core>
 
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace flexiblesusy {
 namespace database {
 
+/**
+ * @class Database
+ * @brief SQLite database with tables of doubles
+ *
+ * For each table the INSERT statement is prepared only once and the
+ * values are bound as native doubles.  Inserted rows are collected
+ * in a transaction, which is committed after
+ * get_rows_per_transaction() rows, when commit() is called or when
+ * the database is closed.  By default every row is committed
+ * immediately.
+ */
 class Database {
 public:
    Database(const std::string& file_name);
@@ -38,15 +57,78 @@ public:
    /// extract a row of doubles from a table
    Eigen::ArrayXd extract(const std::string&, long long);
 
+   /// commit the currently open transaction (if any)
+   void commit();
+   /// set number of inserted rows after which the transaction is committed
+   void set_rows_per_transaction(std::size_t);
+   std::size_t get_rows_per_transaction() const { return rows_per_transaction; }
+   /// switch to write-ahead log journal mode
+   void enable_write_ahead_log();
+
 private:
-   using TCallback = int (*)(void*, int, char**, char**);
+   /// prepared INSERT statement of a table
+   struct Insert_statement {
+      std::vector<std::string> names{}; ///< column names
+      sqlite3_stmt* stmt{nullptr};      ///< prepared statement
+   };
 
    sqlite3* db{nullptr}; ///< pointer to database object
+   std::map<std::string, Insert_statement> insert_statements{}; ///< prepared INSERT statements
+   std::size_t rows_per_transaction{1}; ///< number of rows per transaction
+   std::size_t rows_in_transaction{0};  ///< number of rows in open transaction
 
    void execute(const std::string&);
-   void execute(const std::string&, TCallback, void*);
    template <typename T>
    void create_table(const std::string&, const std::vector<std::string>&);
+   sqlite3_stmt* get_insert_statement(const std::string&, const std::vector<std::string>&);
+   void finalize_insert_statements();
+};
+
+/**
+ * @class Database_writer
+ * @brief Writes rows to a database from a dedicated thread
+ *
+ * insert() may be called concurrently from several threads (for
+ * example from the workers of a parameter scan).  The rows are put
+ * into a queue, which is emptied by a single writer thread that owns
+ * the database connection.  The writer commits a transaction after
+ * each rows_per_transaction rows and whenever the queue runs empty.
+ *
+ * Errors which occur in the writer thread are re-thrown by the next
+ * call of flush().  The destructor writes all remaining rows.
+ */
+class Database_writer {
+public:
+   explicit Database_writer(const std::string& file_name, std::size_t rows_per_transaction = 1000);
+   Database_writer(const Database_writer&) = delete;
+   Database_writer(Database_writer&&) = delete;
+   ~Database_writer();
+
+   /// queue a row of doubles for insertion into a table (thread-safe)
+   void insert(std::string, std::vector<std::string>, Eigen::ArrayXd);
+
+   /// wait until all queued rows are written and committed
+   void flush();
+
+private:
+   /// row waiting to be written
+   struct Row {
+      std::string table{};
+      std::vector<std::string> names{};
+      Eigen::ArrayXd data{};
+   };
+
+   Database db;
+   std::deque<Row> queue{};              ///< rows waiting to be written
+   std::size_t rows_in_progress{0};      ///< rows taken from queue, not yet committed
+   bool stop{false};                     ///< tells the writer thread to finish
+   std::exception_ptr error{};           ///< first error of the writer thread
+   std::mutex mutex{};
+   std::condition_variable row_queued{}; ///< signals new rows or stop
+   std::condition_variable rows_done{};  ///< signals that rows were committed
+   std::thread writer{};
+
+   void write_queue();
 };
 
 } // namespace database
@@ -18,9 +18,11 @@
 
 #include "dilog.hpp"
 #include "complex.hpp"
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <limits>
+#include <Eigen/Core>
 
 namespace flexiblesusy {
 
@@ -53,6 +55,31 @@ namespace {
       return Complex<T>(z.re*a + b, z.im*a);
    }
 
+   /// maximum number of arguments processed at once by the array versions
+   constexpr std::size_t BATCH_SIZE = 64;
+
+   using Batch_array = Eigen::Array<double, Eigen::Dynamic, 1, 0, BATCH_SIZE, 1>;
+   using Batch_map = Eigen::Map<const Eigen::ArrayXd>;
+
+   template <int N>
+   Batch_array horner(const Batch_array& x, const double (&c)[N]) noexcept
+   {
+      Batch_array p = Batch_array::Constant(x.size(), c[N - 1]);
+      for (int i = N - 2; i >= 0; --i) {
+         p = p*x + c[i];
+      }
+      return p;
+   }
+
+   /// calls f(first, count) for consecutive chunks of at most BATCH_SIZE elements
+   template <typename F>
+   void for_each_batch(std::size_t n, F&& f)
+   {
+      for (std::size_t i = 0; i < n; i += BATCH_SIZE) {
+         f(i, static_cast<Eigen::Index>(std::min(BATCH_SIZE, n - i)));
+      }
+   }
+
 } // anonymous namespace
 
 /**
@@ -479,4 +506,118 @@ std::complex<long double> dilog(const std::complex<long double>& z_) noexcept
    return sgn*(cz + cz2*(bf[0] + cz*horner<1, N-1>(cz2, bf))) + cy;
 }
 
+/**
+ * @brief Real dilogarithm \f$\mathrm{Li}_2(x)\f$ of n arguments
+ * @param x array of n real arguments
+ * @param result array of n results
+ * @param n number of arguments
+ *
+ * Convenience wrapper, which calls the scalar version for each
+ * argument.
+ */
+void dilog(const double* x, double* result, std::size_t n) noexcept
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      result[i] = dilog(x[i]);
+   }
+}
+
+/**
+ * @brief Complex dilogarithm \f$\mathrm{Li}_2(z)\f$ of n arguments
+ * @param z array of n complex arguments
+ * @param result array of n results
+ * @param n number of arguments
+ *
+ * Convenience wrapper, which calls the scalar version for each
+ * argument.
+ */
+void dilog(const std::complex<double>* z, std::complex<double>* result, std::size_t n) noexcept
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      result[i] = dilog(z[i]);
+   }
+}
+
+/**
+ * @brief Clausen function \f$\mathrm{Cl}_2(\theta)\f$ of n arguments
+ * @param x array of n real angles
+ * @param result array of n results
+ * @param n number of arguments
+ *
+ * After reduction to \f$[0,\pi]\f$ the Clausen function is evaluated
+ * from its series expansions around \f$\theta = 0\f$ and
+ * \f$\theta = \pi\f$,
+ * \f{align*}{
+ *   \mathrm{Cl}_2(\theta) &= \theta - \theta\log\theta
+ *     + \sum_{k\geq 1} c_k \theta^{2k+1}, &
+ *   \mathrm{Cl}_2(\pi - t) &= t\log 2 - \sum_{k\geq 1} (4^k - 1) c_k t^{2k+1},
+ * \f}
+ * with \f$c_k = |B_{2k}|/(2k(2k+1)!)\f$, where the first one is
+ * used for \f$\theta \leq 2\pi/3\f$.
+ */
+void clausen_2(const double* x, double* result, std::size_t n) noexcept
+{
+   const double PI = 3.141592653589793;
+   const double eps = std::numeric_limits<double>::epsilon();
+   const double C[] = {
+      1.0, // coefficient of theta
+      1.38888888888888881e-02,
+      6.94444444444444444e-05,
+      7.87351977828168297e-07,
+      1.14822163433274551e-08,
+      1.89788699889709990e-10,
+      3.38730137095352120e-12,
+      6.37263644318318076e-14,
+      1.24620599129506715e-15,
+      2.51054446089995455e-17,
+      5.17825880609062320e-19,
+      1.08873573683008492e-20,
+      2.32574411430208708e-22,
+      5.03519521314738965e-24,
+      1.10264992943812150e-25,
+      2.43865855090073440e-27,
+      5.44014267885625274e-29
+   };
+   const double D[] = {
+      0.69314718055994531, // log(2)
+     -4.16666666666666644e-02,
+     -1.04166666666666665e-03,
+     -4.96031746031746031e-05,
+     -2.92796516754850097e-06,
+     -1.94153839987173309e-07,
+     -1.38709991140546691e-08,
+     -1.04402902848670035e-09,
+     -8.16701096395222367e-11,
+     -6.58121656613696748e-12,
+     -5.42979272759647510e-13,
+     -4.56648756719363559e-14,
+     -3.90195090406306918e-15,
+     -3.37906225737363958e-16,
+     -2.95990335514440040e-17,
+     -2.61848967811869307e-18,
+     -2.33652348858212908e-19
+   };
+
+   for_each_batch(n, [&] (std::size_t first, Eigen::Index len) {
+      const Batch_map xs(x + first, len);
+
+      // reduce to [0, 2pi)
+      const Batch_array th = xs - 2*PI*(xs/(2*PI)).floor();
+      // Cl2(2pi - theta) = -Cl2(theta)
+      const Batch_array sgn = (th > PI).select(Batch_array::Constant(len, -1.0), 1.0);
+      const Batch_array t = (th > PI).select(2*PI - th, th);
+
+      const Batch_array small = (t <= 2*PI/3).select(t, 1.0);
+      const Batch_array u = PI - t;
+      const Batch_array cl_0 = small*(horner(small.square(), C) - small.log());
+      const Batch_array cl_pi = u*horner(u.square(), D);
+
+      const Batch_array res = sgn*(t <= 2*PI/3).select(cl_0, cl_pi);
+
+      Eigen::Map<Eigen::ArrayXd>(result + first, len) =
+         ((th.abs() < eps) || ((th - PI).abs() < eps) || ((th - 2*PI).abs() < eps))
+         .select(Batch_array::Zero(len), res);
+   });
+}
+
 } // namespace flexiblesusy
@@ -20,6 +20,7 @@
 #define DILOG_H
 
 #include <complex>
+#include <cstddef>
 
 #define DILOGATTR noexcept
 
@@ -43,6 +44,15 @@ double clausen_2(double) DILOGATTR;
 /// Clausen function Cl_2(x)
 long double clausen_2(long double) DILOGATTR;
 
+/// real dilogarithm of n arguments
+void dilog(const double*, double*, std::size_t) DILOGATTR;
+
+/// complex dilogarithm of n arguments
+void dilog(const std::complex<double>*, std::complex<double>*, std::size_t) DILOGATTR;
+
+/// Clausen function Cl_2(x) of n arguments
+void clausen_2(const double*, double*, std::size_t) DILOGATTR;
+
 } // namespace flexiblesusy
 
 #undef DILOGATTR
@@ -0,0 +1,65 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gsl_multiroot_fdfsolver.hpp"
+#include "logger.hpp"
+#include "error.hpp"
+#include <string>
+
+namespace flexiblesusy {
+
+GSL_multiroot_fdfsolver::GSL_multiroot_fdfsolver(
+   const gsl_multiroot_fdfsolver_type* type, std::size_t dim,
+   gsl_multiroot_function_fdf* f, const GSL_vector& start)
+{
+   solver = gsl_multiroot_fdfsolver_alloc(type, dim);
+
+   if (!solver) {
+      throw OutOfMemoryError(
+         std::string("Cannot allocate gsl_multiroot_fdfsolver ") +
+         type->name);
+   }
+
+   gsl_multiroot_fdfsolver_set(solver, f, start.raw());
+}
+
+GSL_multiroot_fdfsolver::~GSL_multiroot_fdfsolver() noexcept
+{
+   gsl_multiroot_fdfsolver_free(solver);
+}
+
+GSL_vector GSL_multiroot_fdfsolver::get_root() const { return solver->x; }
+
+int GSL_multiroot_fdfsolver::iterate()
+{
+   return gsl_multiroot_fdfsolver_iterate(solver);
+}
+
+void GSL_multiroot_fdfsolver::print_state(std::size_t iteration) const
+{
+   VERBOSE_MSG("\t\t\tIteration " << iteration
+                                  << ": x = " << GSL_vector(solver->x)
+                                  << ", f(x) = " << GSL_vector(solver->f));
+}
+
+int GSL_multiroot_fdfsolver::test_residual(double precision) const noexcept
+{
+   return gsl_multiroot_test_residual(solver->f, precision);
+}
+
+} // namespace flexiblesusy
@@ -0,0 +1,52 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GSL_MULTIROOT_FDFSOLVER_H
+#define GSL_MULTIROOT_FDFSOLVER_H
+
+#include "gsl_vector.hpp"
+#include <gsl/gsl_multiroots.h>
+
+namespace flexiblesusy {
+
+/**
+ * RAII wrapper for gsl_multiroot_fdfsolver
+ */
+class GSL_multiroot_fdfsolver
+{
+public:
+   GSL_multiroot_fdfsolver(const gsl_multiroot_fdfsolver_type* type, std::size_t dim,
+                           gsl_multiroot_function_fdf* f, const GSL_vector& start);
+   GSL_multiroot_fdfsolver(const GSL_multiroot_fdfsolver&) = delete;
+   GSL_multiroot_fdfsolver(GSL_multiroot_fdfsolver&&) = delete;
+   ~GSL_multiroot_fdfsolver() noexcept;
+   GSL_multiroot_fdfsolver& operator=(const GSL_multiroot_fdfsolver&) = delete;
+   GSL_multiroot_fdfsolver& operator=(GSL_multiroot_fdfsolver&&) = delete;
+
+   GSL_vector get_root() const;
+   int iterate();
+   void print_state(std::size_t iteration) const;
+   int test_residual(double precision) const noexcept;
+
+private:
+   gsl_multiroot_fdfsolver* solver = nullptr;
+};
+
+} // namespace flexiblesusy
+
+#endif
@@ -0,0 +1,103 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "lattice_band_solver.hpp"
+#include "profiling.hpp"
+
+#include <chrono>
+
+extern "C" void dgbtrf_
+(const int& M, const int& N, const int& KL, const int& KU,
+ double *AB, const int& LDAB, int *IPIV, int *INFO);
+
+extern "C" void dgbtrs_
+(const char& TRANS, const int& N, const int& KL, const int& KU,
+ const int& NRHS, const double *AB, const int& LDAB, const int *IPIV,
+ double *B, const int& LDB, int *INFO, std::size_t TRANS_len);
+
+namespace flexiblesusy {
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(
+	std::chrono::steady_clock::now() - start).count();
+}
+
+} // anonymous namespace
+
+void Lattice_band_solver::analyze(size_t N, size_t KL, size_t KU)
+{
+    if (lu == nullptr || lu->size() != N || lu->lower() != KL ||
+	lu->upper() != KU) {
+	delete lu;
+	lu = new band_matrix<double>(N, KL, KU, 2*KL + KU + 1);
+	ipiv.resize(N);
+    }
+    factorized = false;
+}
+
+int Lattice_band_solver::factorize(band_matrix<double>& A)
+{
+    PROFILE_SCOPE("RGFlow<Lattice> LU factorization");
+    const auto start = std::chrono::steady_clock::now();
+
+    assert(lu != nullptr);
+
+    // take over the storage of A instead of copying it
+    lu->swap(A);
+
+    const int N = lu->size();
+    int INFO = 0;
+    dgbtrf_(N, N, lu->lower(), lu->upper(), lu->pointer(),
+	    lu->leading_dimension(), &ipiv[0], &INFO);
+
+    factorized = INFO == 0;
+    n_factorizations++;
+    factorization_time += seconds_since(start);
+
+    return INFO;
+}
+
+void Lattice_band_solver::solve(double *b) const
+{
+    PROFILE_SCOPE("RGFlow<Lattice> LU solve");
+    const auto start = std::chrono::steady_clock::now();
+
+    assert(factorized);
+
+    const int N = lu->size();
+    int INFO = 0;
+    dgbtrs_('N', N, lu->lower(), lu->upper(), 1, lu->pointer(),
+	    lu->leading_dimension(), &ipiv[0], b, N, &INFO, 1);
+    assert(INFO == 0);
+
+    n_solves++;
+    solve_time += seconds_since(start);
+}
+
+void Lattice_band_solver::clear_statistics()
+{
+    n_factorizations = 0;
+    n_solves = 0;
+    factorization_time = 0;
+    solve_time = 0;
+}
+
+} // namespace flexiblesusy
@@ -0,0 +1,145 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef lattice_band_solver_hpp
+#define lattice_band_solver_hpp
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+
+namespace flexiblesusy {
+
+/**
+ * @class band_matrix
+ * @brief N x N band matrix in the storage layout of LAPACK's DGBTRF
+ *
+ * The leading dimension LD must be at least KL+KU+1.  For an LU
+ * factorization with DGBTRF it must be at least 2*KL+KU+1, because
+ * the additional KL rows hold the fill-in.
+ */
+template<class T>
+class band_matrix {
+public:
+    band_matrix(size_t N, size_t KL, size_t KU, size_t LD) :
+	n(N), kl(KL), ku(KU), ld(LD) {
+	assert(ld >= kl+ku+1);
+	AB = new T[ld*n];
+    }
+    ~band_matrix() { delete[] AB; }
+    band_matrix(const band_matrix&) = delete;
+    band_matrix& operator=(const band_matrix&) = delete;
+    T *pointer() { return AB; }
+    const T *pointer() const { return AB; }
+    size_t size() const { return n; }
+    size_t lower() const { return kl; }
+    size_t upper() const { return ku; }
+    size_t leading_dimension() const { return ld; }
+    void clear() { for (size_t i = 0; i < ld*n; i++) AB[i] = 0; }
+    T& operator()(size_t i, size_t j) {
+	assert(i < n && j < n && i+ku >= j && i <= j+kl);
+	size_t idx = kl+ku+i-j + ld*j;
+	assert(idx < ld*n);
+	return AB[idx];
+    }
+    T operator()(size_t i, size_t j) const {
+	assert(i < n && j < n && i+ku >= j && i <= j+kl);
+	return AB[kl+ku+i-j + ld*j];
+    }
+    /// y -= A x
+    void subtract_product(const T *x, T *y) const {
+	for (size_t j = 0; j < n; j++) {
+	    const T xj = x[j];
+	    if (xj == 0) continue;
+	    const size_t ibegin = j > ku ? j-ku : 0;
+	    const size_t iend = std::min(n, j+kl+1);
+	    for (size_t i = ibegin; i < iend; i++)
+		y[i] -= AB[kl+ku+i-j + ld*j] * xj;
+	}
+    }
+    /// exchanges the contents with a matrix of the same shape
+    void swap(band_matrix& other) {
+	assert(n == other.n && kl == other.kl && ku == other.ku &&
+	       ld == other.ld);
+	std::swap(AB, other.AB);
+    }
+
+private:
+    size_t n, kl, ku, ld;
+    T *AB;
+};
+
+/**
+ * @class Lattice_band_solver
+ * @brief LU solver for the linearized lattice equations
+ *
+ * The rows of the lattice equations are sorted by site, and each row
+ * couples at most the variables of neighbouring sites, so the matrix
+ * is block-tridiagonal within each EFT.  analyze() takes the
+ * bandwidths derived from this structure and allocates the LU
+ * storage once per lattice layout; factorize() and solve() then
+ * reuse it in every Newton iteration.
+ *
+ * The last LU factorization is kept, so that the caller can solve
+ * further right-hand sides with it (chord iterations) instead of
+ * factorizing a new matrix.
+ */
+class Lattice_band_solver {
+public:
+    Lattice_band_solver() = default;
+    Lattice_band_solver(const Lattice_band_solver&) = delete;
+    Lattice_band_solver& operator=(const Lattice_band_solver&) = delete;
+    ~Lattice_band_solver() { delete lu; }
+
+    /// allocates storage for N x N matrices with KL/KU sub-/superdiagonals
+    void analyze(size_t N, size_t KL, size_t KU);
+    /// LU-factorizes A; A is left in an unspecified state
+    /// @return 0 on success, INFO of DGBTRF otherwise
+    int factorize(band_matrix<double>& A);
+    /// solves A x = b with the last factorization, b is overwritten by x
+    void solve(double *b) const;
+    /// returns true if a valid factorization is available
+    bool is_factorized() const { return factorized; }
+    /// invalidates the factorization
+    void reset() { factorized = false; }
+
+    size_t get_number_of_factorizations() const { return n_factorizations; }
+    size_t get_number_of_solves() const { return n_solves; }
+    /// total time spent in factorize() in seconds
+    double get_factorization_time() const { return factorization_time; }
+    /// total time spent in solve() in seconds
+    double get_solve_time() const { return solve_time; }
+    void clear_statistics();
+
+private:
+    band_matrix<double> *lu = nullptr;
+    std::vector<int> ipiv;
+    bool factorized = false;
+    size_t n_factorizations = 0;
+    mutable size_t n_solves = 0;
+    double factorization_time = 0;
+    mutable double solve_time = 0;
+};
+
+} // namespace flexiblesusy
+
+#endif // lattice_band_solver_hpp
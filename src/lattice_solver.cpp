@@ -10,6 +10,8 @@
 #include "lattice_solver.hpp"
 #include "rk.hpp"
 #include "logger.hpp"
+#include "global_thread_pool.hpp"
+#include "thread_pool.hpp"
 
 
 namespace flexiblesusy {
@@ -48,6 +50,7 @@ RGFlow<Lattice>::RGFlow() :
     tiny_dy(1e-2), huge_dy(100),
     max_a_steps(1024), max_iter(100),
     units_set(false), hybrid(false), scl0(1),
+    A_(nullptr), chord(false), chord_contraction(0.5),
     multithreading(true)
 {
 }
@@ -160,16 +163,14 @@ void RGFlow<Lattice>::solve()
 	throw SetupError("RGFlow<Lattice>::Error: EFT tower empty");
 
     init_lattice();
-    create_threads();
+    update_constraint_tasks();
     increase_a();
     if (hybrid) rk_stage();
     else increase_density();
-    join_threads();
 }
 
 void RGFlow<Lattice>::init_lattice()
 {
-    size_t max_width = 0;
     size_t offset = 0;
     for (size_t T = 0; T < efts.size(); T++) {
 	efts[T].w->init(this, T);
@@ -183,9 +184,7 @@ void RGFlow<Lattice>::init_lattice()
 	efts[T].height = height;
 	efts[T].T = T;
 	efts[T].offset = offset;
-	size_t width = efts[T].w->width;
-	if (width > max_width) max_width = width;
-	offset += width * height;
+	offset += efts[T].w->width * height;
     }
     y_.resize(offset);
     z.resize(offset);
@@ -212,14 +211,7 @@ void RGFlow<Lattice>::init_lattice()
 
     for (auto c: constraints) c->alloc_rows();
     sort_rows();
-
-    N = y_.size();
-    KL = KU = 2*max_width;
-    LDA = 2*KL + KU + 1;
-    IPIV.resize(N);
-    A_ = new band_matrix<Real>(N, KL, KU, LDA);
-    if (A_ == nullptr)
-	throw MemoryError("RGFlow<Lattice>::Error: failed to allocate matrix");
+    analyze_structure();
 }
 
 void RGFlow<Lattice>::increase_a()
@@ -371,8 +363,6 @@ void RGFlow<Lattice>::rk_stage()
 
 void RGFlow<Lattice>::enable_Runge_Kutta()
 {
-    join_threads();
-
     vector<vector<bool>> original(efts.size());
     for (size_t T = efts.size(); T--; ) {
 	original[T].resize(efts[T].height);
@@ -405,14 +395,13 @@ void RGFlow<Lattice>::enable_Runge_Kutta()
 	}
     for (auto i: rgeidx) constraints[i]->alloc_rows();
     sort_rows();
+    analyze_structure();
 
-    create_threads();
+    update_constraint_tasks();
 }
 
 void RGFlow<Lattice>::disable_Runge_Kutta()
 {
-    join_threads();
-
     VERBOSE_MSG("switching to difference RGEs");
     for (size_t i = 0, T = 0; T < efts.size(); T++)
 	for (size_t m = 0; m < efts[T].height-1; m++, i++) {
@@ -425,8 +414,9 @@ void RGFlow<Lattice>::disable_Runge_Kutta()
 	}
     for (auto i: rgeidx) constraints[i]->alloc_rows();
     sort_rows();
+    analyze_structure();
 
-    create_threads();
+    update_constraint_tasks();
 }
 
 void RGFlow<Lattice>::resample(const vector<vector<size_t>>& site_maps)
@@ -493,13 +483,7 @@ void RGFlow<Lattice>::resample(const vector<vector<size_t>>& site_maps)
     }
     for (auto c: constraints) c->alloc_rows();
     sort_rows();
-
-    N = y_.size();
-    IPIV.resize(N);
-    delete A_;
-    A_ = new band_matrix<Real>(N, KL, KU, LDA);
-    if (A_ == nullptr)
-	throw MemoryError("RGFlow<Lattice>::Error: failed to allocate matrix");
+    analyze_structure();
 }
 
 void RGFlow<Lattice>::set_units()
@@ -528,52 +512,21 @@ void RGFlow<Lattice>::apply_constraints()
 {
     A_->clear();
 
-    if (multithreading) {
-	threads_begin->wait();
-	(**elementary_constraints.begin())();
-	threads_end->wait();
-    }
+    if (multithreading)
+	global_thread_pool().parallel_for(
+	    0, constraint_tasks.size(),
+	    [this] (size_t k) { (*constraint_tasks[k])(); });
     else
 	for (auto c: elementary_constraints) (*c)();
 
     // for (auto c: constraints) (*c)();
 }
 
-void RGFlow<Lattice>::apply_constraints_thread(Lattice_constraint *c)
+void RGFlow<Lattice>::update_constraint_tasks()
 {
-    while (threads_begin->wait(), keep_threads) {
-	(*c)();
-	threads_end->wait();
-    }
-}
-
-void RGFlow<Lattice>::create_threads()
-{
-    if (!multithreading) return;
-
-    threads_begin = new boost::barrier(elementary_constraints.size());
-    threads_end   = new boost::barrier(elementary_constraints.size());
-    keep_threads = true;
-    threads = new boost::thread_group;
-    for (auto c: elementary_constraints)
-	if (c != *elementary_constraints.begin())
-	    threads->add_thread(
-		new boost::thread
-		(&RGFlow<Lattice>::apply_constraints_thread, this, c));
-    VERBOSE_MSG("launched " << threads->size() << " subthreads");
-}
-
-void RGFlow<Lattice>::join_threads()
-{
-    if (!multithreading) return;
-
-    keep_threads = false;
-    threads_begin->wait();
-    threads->join_all();
-    VERBOSE_MSG("joined " << threads->size() << " subthreads");
-    delete threads;
-    delete threads_begin;
-    delete threads_end;
+    constraint_tasks.assign(elementary_constraints.begin(),
+			    elementary_constraints.end());
+    VERBOSE_MSG(constraint_tasks.size() << " elementary constraints");
 }
 
 Real RGFlow<Lattice>::maxdiff(const RVec& y0, const RVec& y1)
@@ -635,9 +588,42 @@ void RGFlow<Lattice>::init_free_row_list()
     free_row_list_head = &row_pool[0];
 }
 
-extern "C" void dgbsv_
-(const int& N, const int& KL, const int& KU, const int& NRHS,
- double *AB, const int& LDAB, int *IPIV, double *B, const int& LDB, int *INFO);
+/**
+ * Determines the lower and upper bandwidths of the linearized
+ * equations from the sites spanned by each row and allocates the
+ * matrix and the LU solver accordingly.  Since a row couples only
+ * neighbouring sites, the bandwidths are of the order of the EFT
+ * widths, independent of the number of sites.  The layout changes
+ * only when rows are reallocated, so this is done once per
+ * sort_rows() rather than in every iteration.
+ */
+void RGFlow<Lattice>::analyze_structure()
+{
+    size_t kl = 0, ku = 0;
+
+    for (const auto& r: row_pool) {
+	const auto& spec = r.rowSpec;
+	const size_t row = spec.realRow;
+	const size_t first_col = site_offset(spec.T, spec.m);
+	size_t T = spec.T, m = spec.m, end_col = first_col;
+	for (size_t n = 0; n < spec.n; n++, m++) {
+	    if (m == efts[T].height) { T++; m = 0; }
+	    end_col = site_offset(T, m) + efts[T].w->width;
+	}
+	if (row > first_col) kl = max(kl, row - first_col);
+	if (end_col - 1 > row) ku = max(ku, end_col - 1 - row);
+    }
+
+    N = y_.size();
+    KL = kl;
+    KU = ku;
+    LDA = 2*KL + KU + 1;
+    delete A_;
+    A_ = new band_matrix<Real>(N, KL, KU, LDA);
+    linear_solver.analyze(N, KL, KU);
+
+    VERBOSE_MSG("linear system: N=" << N << " KL=" << KL << " KU=" << KU);
+}
 
 RGFlow<Lattice>::Inner_status RGFlow<Lattice>::iterate()
 {
@@ -648,9 +634,8 @@ RGFlow<Lattice>::Inner_status RGFlow<Lattice>::iterate()
     size_t iter = 0;
     enum { END, INIT } state = INIT;
 
-    int NRHS = 1;
-    int LDB = N;
-    int INFO;
+    bool refactorize = true;
+    Real last_maxdy = 0;
 
     while (iter < max_iter && state != END) {
 	iter++;
@@ -660,29 +645,56 @@ RGFlow<Lattice>::Inner_status RGFlow<Lattice>::iterate()
 	for (size_t i = 0; i < y_.size(); i++) {
 	    for (size_t j = 0; j < y_.size(); j++) {
 		if (j) cout << " ";
-		if (abs(signed(i)-signed(j)) < KL) cout << (*A_)(i,j);
+		if (signed(j)-signed(i) <= KU && signed(i)-signed(j) <= KL)
+		    cout << (*A_)(i,j);
 		else cout << 0;
 	    }
 	    cout << "\n";
 	}
 #endif
-	dgbsv_(N,KL,KU,NRHS,A_->pointer(),LDA,&IPIV[0],&z[0],LDB,&INFO);
-	assert(INFO >= 0);
-	if (INFO > 0) {
-	    stringstream msg;
-	    msg << "RGFlow<Lattice>::Error: failed to solve equations, "
-		   "DGBSV returned INFO = " << INFO;
-	    throw NonInvertibleMatrixError(msg.str());
+	const bool chord_step =
+	    chord && !refactorize && linear_solver.is_factorized();
+	if (chord_step) {
+	    // y + A0^{-1} (z - A y) with the factorization A0 of an
+	    // earlier iteration
+	    A_->subtract_product(&y_[0], &z[0]);
+	    linear_solver.solve(&z[0]);
+	    for (size_t i = 0; i < z.size(); i++) z[i] += y_[i];
+	}
+	else {
+	    const int INFO = linear_solver.factorize(*A_);
+	    assert(INFO >= 0);
+	    if (INFO > 0) {
+		stringstream msg;
+		msg << "RGFlow<Lattice>::Error: failed to solve equations, "
+		       "DGBTRF returned INFO = " << INFO;
+		throw NonInvertibleMatrixError(msg.str());
+	    }
+	    linear_solver.solve(&z[0]);
 	}
 	Real maxdy = maxdiff(y_, z);
-	VERBOSE_MSG("iter=" << iter << " maxdy=" << maxdy);
+	VERBOSE_MSG("iter=" << iter << " maxdy=" << maxdy
+		    << (chord_step ? " (chord)" : ""));
 	if (maxdy < tiny_dy)
 	    state = END;
-	else if (maxdy > huge_dy)
-	    return JUMPED;
+	else if (maxdy > huge_dy) {
+	    if (!chord_step) return JUMPED;
+	    // discard the step and retry with a fresh factorization
+	    refactorize = true;
+	    continue;
+	}
+	// keep the factorization as long as the iteration contracts well
+	refactorize = chord_step && maxdy > chord_contraction * last_maxdy;
+	last_maxdy = maxdy;
 	y_ = z;
     }
 
+    VERBOSE_MSG(linear_solver.get_number_of_factorizations()
+		<< " LU factorizations in "
+		<< linear_solver.get_factorization_time() << " s, "
+		<< linear_solver.get_number_of_solves() << " solves in "
+		<< linear_solver.get_solve_time() << " s so far");
+
     if (state == END) {
 	VERBOSE_MSG("converged after " << iter << " Newton iterations");
 	return CONVERGED;
@@ -28,12 +28,11 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cassert>
-#include <boost/thread/thread.hpp>
-#include <boost/thread/barrier.hpp>
 #include "mathdefs.hpp"
 
 #include "rg_flow.hpp"
 #include "error.hpp"
+#include "lattice_band_solver.hpp"
 #include "lattice_model.hpp"
 
 namespace flexiblesusy {
@@ -58,30 +57,6 @@ class Two_scale_running_precision;
 using RVec = std::vector<Real>;
 
 
-template<class T>
-class band_matrix {
-public:
-    band_matrix(size_t N, size_t KL, size_t KU, size_t LD) :
-	n(N), kl(KL), ku(KU), ld(LD) {
-	assert(ld >= kl+ku+1);
-	AB = new T[ld*n];
-    }
-    ~band_matrix() { delete[] AB; }
-    T *pointer() { return AB; }
-    void clear() { for (size_t i = 0; i < ld*n; i++) AB[i] = 0; }
-    T& operator()(size_t i, size_t j) {
-	assert(i < n && j < n && i+ku >= j && i <= j+kl);
-	size_t idx = kl+ku+i-j + ld*j;
-	assert(idx < ld*n);
-	return AB[idx];
-    }
-
-private:
-    size_t n, kl, ku, ld;
-    T *AB;
-};
-
-			      
 template<>
 class RGFlow<Lattice> {
 public:
@@ -201,6 +176,13 @@ public:
     void set_initial_guesser(Initial_guesser<Lattice>*);
 
     void enable_hybrid() { hybrid = true; }
+    /// reuse the LU factorization in the Newton iterations as long as
+    /// each step reduces the change of y by at least the given factor
+    void enable_chord_iterations(Real contraction = 0.5)
+    { chord = true; chord_contraction = contraction; }
+    void disable_chord_iterations() { chord = false; }
+    const Lattice_band_solver& get_linear_solver() const
+    { return linear_solver; }
     void disable_multithreading() { multithreading = false; };
     void solve();
     friend std::ostream& operator<<(std::ostream &out, const RGFlow& flow);
@@ -231,7 +213,9 @@ public:
     std::vector<EqRow> row_pool;
     EqRow *free_row_list_head;
     int N, KL, KU, LDA;		// for lapack
-    std::vector<int> IPIV;	// ditto
+    Lattice_band_solver linear_solver;
+    bool chord;			// reuse LU factorization across iterations
+    Real chord_contraction;
     int verb;
     // std::ostream *log;
     size_t site_offset(size_t T, size_t m) const {
@@ -250,17 +234,12 @@ public:
     std::vector<size_t> rgeidx;
     std::unordered_set<Lattice_constraint*> elementary_constraints;
     bool multithreading;
-    // as of v1.52 boost::thread gives valgrind the impression that
-    // 8 bytes are not freed at exit
-    // see http://www.cplusplus.com/forum/unices/83480/
-    boost::thread_group *threads;
-    boost::barrier *threads_begin, *threads_end;
-    bool keep_threads;
+    // snapshot of elementary_constraints, dispatched in chunks onto
+    // the global thread pool by apply_constraints()
+    std::vector<Lattice_constraint*> constraint_tasks;
     void set_units();
     void apply_constraints();
-    void apply_constraints_thread(Lattice_constraint *c);
-    void create_threads();
-    void join_threads();
+    void update_constraint_tasks();
     Real maxdiff(const RVec& y0, const RVec& y1);
     void init_lattice();
     void increase_a();
@@ -275,6 +254,7 @@ public:
     void rfree(EqRow *r);
     void init_free_row_list();
     void sort_rows();
+    void analyze_structure();
 };
 
 } // namespace flexiblesusy
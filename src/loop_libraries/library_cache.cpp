@@ -0,0 +1,194 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "library_cache.hpp"
+#include <boost/preprocessor/tuple/elem.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+#define ARG_NAMES(SEQ) BOOST_PP_SEQ_ENUM(SEQ), scl2_in
+#define FORWARD(R, ARGS_AND_NAMES, NAME)                                       \
+   std::complex<double> Cache::NAME BOOST_PP_TUPLE_ELEM(2, 0, ARGS_AND_NAMES)  \
+   {                                                                           \
+      return library->NAME BOOST_PP_TUPLE_ELEM(2, 1, ARGS_AND_NAMES);          \
+   }
+
+namespace flexiblesusy
+{
+namespace looplibrary
+{
+
+namespace {
+
+enum class Function : std::uint64_t { A0, B0, B1, B00, A, B };
+
+/// function, cache id and bits of the arguments
+using Key = std::array<std::uint64_t, 8>;
+
+struct Key_hash {
+   std::size_t operator()(const Key& key) const noexcept
+   {
+      std::uint64_t h = 14695981039346656037ULL;
+      for (const auto k: key) {
+         h = (h ^ k) * 1099511628211ULL;
+         h ^= h >> 29;
+      }
+      return static_cast<std::size_t>(h);
+   }
+};
+
+/// values stored by one thread
+struct Thread_storage {
+   std::unordered_map<Key, Bcoeff_t, Key_hash> values{};
+   Cache::Statistics statistics{};
+};
+
+thread_local Thread_storage storage;
+
+std::atomic<unsigned> next_id{0};
+
+std::uint64_t bits(double x) noexcept
+{
+   std::uint64_t b;
+   std::memcpy(&b, &x, sizeof(b));
+   return b;
+}
+
+Key make_key(Function f, unsigned id, std::complex<double> x0,
+             std::complex<double> x1, std::complex<double> x2,
+             double scl2) noexcept
+{
+   return {{(static_cast<std::uint64_t>(id) << 8) | static_cast<std::uint64_t>(f),
+            bits(x0.real()), bits(x0.imag()), bits(x1.real()), bits(x1.imag()),
+            bits(x2.real()), bits(x2.imag()), bits(scl2)}};
+}
+
+/**
+ * Returns the stored value for the given key.  If there is no stored
+ * value, the value is calculated by calling calc and is stored.
+ */
+template <typename F>
+const Bcoeff_t& lookup(const Key& key, std::size_t max_entries, F&& calc)
+{
+   auto& values = storage.values;
+   const auto it = values.find(key);
+
+   if (it != values.end()) {
+      storage.statistics.hits++;
+      return it->second;
+   }
+
+   storage.statistics.misses++;
+
+   if (values.size() >= max_entries) {
+      values.clear();
+   }
+
+   return values.emplace(key, calc()).first->second;
+}
+
+} // anonymous namespace
+
+Cache::Cache(std::unique_ptr<Loop_library_interface> library_, std::size_t max_entries_)
+   : library(std::move(library_))
+   , max_entries(max_entries_)
+   , id(next_id++)
+{
+}
+
+std::complex<double> Cache::A0(A_ARGS)
+{
+   const auto key = make_key(Function::A0, id, m02_in, 0., 0., scl2_in);
+   return lookup(key, max_entries, [&] {
+      return Bcoeff_t{library->A0(m02_in, scl2_in)};
+   })[0];
+}
+
+#define CACHED_B(NAME)                                                         \
+   std::complex<double> Cache::NAME(B_ARGS)                                    \
+   {                                                                           \
+      const auto key =                                                         \
+         make_key(Function::NAME, id, p10_in, m02_in, m12_in, scl2_in);       \
+      return lookup(key, max_entries, [&] {                                    \
+         return Bcoeff_t{library->NAME(p10_in, m02_in, m12_in, scl2_in)};      \
+      })[0];                                                                   \
+   }
+
+CACHED_B(B0)
+CACHED_B(B1)
+CACHED_B(B00)
+
+BOOST_PP_SEQ_FOR_EACH(FORWARD, ((C_ARGS), (ARG_NAMES(C_ARGS_SEQ))), C_SEQ)
+BOOST_PP_SEQ_FOR_EACH(FORWARD, ((D_ARGS), (ARG_NAMES(D_ARGS_SEQ))), D_SEQ)
+
+void Cache::A(Acoeff_t& a, A_ARGS)
+{
+   const auto key = make_key(Function::A, id, m02_in, 0., 0., scl2_in);
+   a[0] = lookup(key, max_entries, [&] {
+      Acoeff_t tmp{};
+      library->A(tmp, m02_in, scl2_in);
+      return Bcoeff_t{tmp[0]};
+   })[0];
+}
+
+void Cache::B(Bcoeff_t& b, B_ARGS)
+{
+   const auto key = make_key(Function::B, id, p10_in, m02_in, m12_in, scl2_in);
+   b = lookup(key, max_entries, [&] {
+      Bcoeff_t tmp{};
+      library->B(tmp, p10_in, m02_in, m12_in, scl2_in);
+      return tmp;
+   });
+}
+
+void Cache::C(Ccoeff_t& c, C_ARGS)
+{
+   library->C(c, ARG_NAMES(C_ARGS_SEQ));
+}
+
+void Cache::D(Dcoeff_t& d, D_ARGS)
+{
+   library->D(d, ARG_NAMES(D_ARGS_SEQ));
+}
+
+std::unique_ptr<Loop_library_interface> Cache::release()
+{
+   return std::move(library);
+}
+
+void Cache::clear()
+{
+   storage.values.clear();
+}
+
+Cache::Statistics Cache::get_statistics()
+{
+   return storage.statistics;
+}
+
+void Cache::reset_statistics()
+{
+   storage.statistics = Statistics{};
+}
+
+} // namespace looplibrary
+} // namespace flexiblesusy
@@ -0,0 +1,86 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef LOOP_LIBRARY_CACHE_H
+#define LOOP_LIBRARY_CACHE_H
+
+#include "loop_library_interface.hpp"
+#include <cstddef>
+#include <memory>
+
+#define CACHE_REDEFINE(R, ARGS, NAME)                                          \
+   std::complex<double> NAME ARGS override;
+
+namespace flexiblesusy
+{
+namespace looplibrary
+{
+/**
+ * @class Cache
+ * @brief memoizing decorator around a loop library
+ *
+ * The one- and two-point functions (A0, B0, B1, B00, A, B) are stored
+ * together with their arguments and are returned from the cache, if
+ * they are called again with bit-wise identical arguments.  The three-
+ * and four-point functions are passed to the wrapped library.
+ *
+ * The cached values are stored per thread, such that no locking is
+ * required.  The values stored in the calling thread are removed by
+ * clear(), which should be called at the beginning of each spectrum
+ * calculation.  If the number of stored values of a thread exceeds
+ * max_entries, the storage of this thread is cleared as well.
+ */
+class Cache : public Loop_library_interface
+{
+public:
+   /// cache hits and misses of one thread
+   struct Statistics {
+      long long hits{0};
+      long long misses{0};
+   };
+
+   explicit Cache(std::unique_ptr<Loop_library_interface>,
+                  std::size_t max_entries = 100000);
+   BOOST_PP_SEQ_FOR_EACH(CACHE_REDEFINE, (A_ARGS), A_SEQ)
+   BOOST_PP_SEQ_FOR_EACH(CACHE_REDEFINE, (B_ARGS), B_SEQ)
+   BOOST_PP_SEQ_FOR_EACH(CACHE_REDEFINE, (C_ARGS), C_SEQ)
+   BOOST_PP_SEQ_FOR_EACH(CACHE_REDEFINE, (D_ARGS), D_SEQ)
+   void A(Acoeff_t&, A_ARGS) override;
+   void B(Bcoeff_t&, B_ARGS) override;
+   void C(Ccoeff_t&, C_ARGS) override;
+   void D(Dcoeff_t&, D_ARGS) override;
+
+   /// returns the wrapped library and leaves the cache empty
+   std::unique_ptr<Loop_library_interface> release();
+
+   /// removes all values stored by the calling thread
+   static void clear();
+   /// returns the cache hits and misses of the calling thread
+   static Statistics get_statistics();
+   /// resets the cache hits and misses of the calling thread
+   static void reset_statistics();
+
+private:
+   std::unique_ptr<Loop_library_interface> library;
+   std::size_t max_entries{100000}; ///< maximum number of values per thread
+   unsigned id{0};                  ///< distinguishes values of different caches
+};
+} // namespace looplibrary
+} // namespace flexiblesusy
+
+#endif // LOOP_LIBRARY_CACHE_H
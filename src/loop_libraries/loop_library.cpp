@@ -18,14 +18,19 @@
 
 #include <cstdlib>
 #include <memory>
+#include <mutex>
+#include <utility>
 
 #include "config.h"
 #include "logger.hpp"
 #include "loop_library.hpp"
 #include "loop_library_interface.hpp"
 
+#include "library_cache.hpp"
 #include "library_softsusy.hpp"
 
+#include <boost/preprocessor/tuple/elem.hpp>
+
 #ifdef ENABLE_COLLIER
 #include "library_collier.hpp"
 #define COLLIER_INFO ", 1 (=COLLIER)"
@@ -50,72 +55,230 @@
 #define STRINGIFY(X) #X
 #define TOSTR(MACROS) STRINGIFY(MACROS)
 
+#define SHARED_ARG_NAMES(SEQ) BOOST_PP_SEQ_ENUM(SEQ), scl2_in
+#define SHARED_FORWARD(R, ARGS_AND_NAMES, NAME)                                \
+   std::complex<double> NAME BOOST_PP_TUPLE_ELEM(2, 0, ARGS_AND_NAMES) override \
+   {                                                                           \
+      return library->NAME BOOST_PP_TUPLE_ELEM(2, 1, ARGS_AND_NAMES);          \
+   }
+
 namespace flexiblesusy
 {
 
-Loop_library::Library Loop_library::type_ = Loop_library::Library::Undefined;
-std::unique_ptr<looplibrary::Loop_library_interface> Loop_library::lib_;
+namespace {
 
-void Loop_library::set_default()
+/**
+ * @class Shared_library
+ * @brief forwards all calls to a process-wide loop library
+ *
+ * The Fortran libraries (COLLIER, LoopTools, FFlite) keep their state
+ * (e.g. the renormalization scale) in global variables.  Therefore,
+ * only one instance of each of these libraries exists in the process,
+ * which is shared between the process-wide loop library and all
+ * contexts.
+ */
+class Shared_library : public looplibrary::Loop_library_interface
 {
-   Loop_library::lib_ = std::make_unique<looplibrary::Softsusy>();
-   Loop_library::type_ = Loop_library::Library::Softsusy;
-   VERBOSE_MSG("Enabling softsusy.");
+public:
+   explicit Shared_library(std::shared_ptr<looplibrary::Loop_library_interface> library_)
+      : library(std::move(library_)) {}
+
+   BOOST_PP_SEQ_FOR_EACH(SHARED_FORWARD, ((A_ARGS), (SHARED_ARG_NAMES(A_ARGS_SEQ))), A_SEQ)
+   BOOST_PP_SEQ_FOR_EACH(SHARED_FORWARD, ((B_ARGS), (SHARED_ARG_NAMES(B_ARGS_SEQ))), B_SEQ)
+   BOOST_PP_SEQ_FOR_EACH(SHARED_FORWARD, ((C_ARGS), (SHARED_ARG_NAMES(C_ARGS_SEQ))), C_SEQ)
+   BOOST_PP_SEQ_FOR_EACH(SHARED_FORWARD, ((D_ARGS), (SHARED_ARG_NAMES(D_ARGS_SEQ))), D_SEQ)
+
+   void A(looplibrary::Acoeff_t& a, A_ARGS) override
+   {
+      library->A(a, SHARED_ARG_NAMES(A_ARGS_SEQ));
+   }
+   void B(looplibrary::Bcoeff_t& b, B_ARGS) override
+   {
+      library->B(b, SHARED_ARG_NAMES(B_ARGS_SEQ));
+   }
+   void C(looplibrary::Ccoeff_t& c, C_ARGS) override
+   {
+      library->C(c, SHARED_ARG_NAMES(C_ARGS_SEQ));
+   }
+   void D(looplibrary::Dcoeff_t& d, D_ARGS) override
+   {
+      library->D(d, SHARED_ARG_NAMES(D_ARGS_SEQ));
+   }
+
+private:
+   std::shared_ptr<looplibrary::Loop_library_interface> library;
+};
+
+/**
+ * Returns a handle to the process-wide instance of the given
+ * (Fortran) loop library.  The instance is created (and the Fortran
+ * library is initialized) only once.
+ */
+template <typename T>
+std::unique_ptr<looplibrary::Loop_library_interface> make_shared_library()
+{
+   static std::mutex mutex;
+   static std::shared_ptr<looplibrary::Loop_library_interface> instance;
+
+   std::lock_guard<std::mutex> lock(mutex);
+
+   if (!instance) {
+      instance = std::make_shared<T>();
+   }
+
+   return std::make_unique<Shared_library>(instance);
 }
 
-void Loop_library::set(int new_type)
+} // anonymous namespace
+
+std::atomic<Loop_library::Library> Loop_library::type_{Loop_library::Library::Undefined};
+std::unique_ptr<looplibrary::Loop_library_interface> Loop_library::lib_;
+bool Loop_library::cache_enabled_ = false;
+std::mutex Loop_library::mutex_;
+thread_local Loop_library_context* Loop_library::context_ = nullptr;
+
+/**
+ * Creates a new loop library.
+ *
+ * @param new_type library type (0 = Softsusy, 1 = COLLIER, 2 =
+ * LoopTools, 3 = FFlite).  If -1, the type is read from the
+ * environment variable FLEXIBLESUSY_LOOP_LIBRARY.
+ * @param type the type of the created library
+ *
+ * @return new loop library.  If the type is unknown or not enabled,
+ * the Softsusy library is returned.  For the Fortran libraries a
+ * handle to the process-wide instance is returned, see
+ * make_shared_library().
+ */
+std::unique_ptr<looplibrary::Loop_library_interface> Loop_library::create(
+   int new_type, Library& type)
 {
-   if (Loop_library::type_ == Loop_library::Library::Undefined) {
-      if (new_type == -1) {
-         if (const char* flag = std::getenv("FLEXIBLESUSY_LOOP_LIBRARY")) {
-            new_type = std::atoi(flag);
-            VERBOSE_MSG("Setting looplibrary using environment variable "
-                        << "FLEXIBLESUSY_LOOP_LIBRARY=" << new_type);
-         }
+   if (new_type == -1) {
+      if (const char* flag = std::getenv("FLEXIBLESUSY_LOOP_LIBRARY")) {
+         new_type = std::atoi(flag);
+         VERBOSE_MSG("Setting looplibrary using environment variable "
+                     << "FLEXIBLESUSY_LOOP_LIBRARY=" << new_type);
       }
-      switch (new_type) {
-      case 0:
-         Loop_library::set_default();
-         break;
+   }
+
+   switch (new_type) {
+   case 0:
+      break;
 #ifdef ENABLE_COLLIER
-      case 1:
-         Loop_library::lib_ = std::make_unique<looplibrary::Collier>();
-         Loop_library::type_ = Loop_library::Library::Collier;
-         VERBOSE_MSG("Enabling COLLIER.");
-         break;
+   case 1:
+      type = Library::Collier;
+      VERBOSE_MSG("Enabling COLLIER.");
+      return make_shared_library<looplibrary::Collier>();
 #endif // ENABLE_COLLIER
 #ifdef ENABLE_LOOPTOOLS
-      case 2:
-         Loop_library::lib_ = std::make_unique<looplibrary::Looptools>();
-         Loop_library::type_ = Loop_library::Library::Looptools;
-         VERBOSE_MSG("Enabling LoopTools.");
-         break;
+   case 2:
+      type = Library::Looptools;
+      VERBOSE_MSG("Enabling LoopTools.");
+      return make_shared_library<looplibrary::Looptools>();
 #endif // ENABLE_LOOPTOOLS
 #ifdef ENABLE_FFLITE
-      case 3:
-         Loop_library::lib_ = std::make_unique<looplibrary::Fflite>();
-         Loop_library::type_ = Loop_library::Library::Fflite;
-         VERBOSE_MSG("Enabling FFlite.");
-         break;
+   case 3:
+      type = Library::Fflite;
+      VERBOSE_MSG("Enabling FFlite.");
+      return make_shared_library<looplibrary::Fflite>();
 #endif // ENABLE_FFLITE
-      default:
-         ERROR("Warning: Check FlexibleSUSY[31]:\n"
-               "Currently configured values are 0 (=softsusy)" COLLIER_INFO
-                  LOOPTOOLS_INFO FFLITE_INFO ".\n"
-               "Setting default library.");
-         Loop_library::set_default();
-         break;
+   default:
+      ERROR("Warning: Check FlexibleSUSY[31]:\n"
+            "Currently configured values are 0 (=softsusy)" COLLIER_INFO
+               LOOPTOOLS_INFO FFLITE_INFO ".\n"
+            "Setting default library.");
+      break;
+   }
+
+   type = Library::Softsusy;
+   VERBOSE_MSG("Enabling softsusy.");
+   return std::make_unique<looplibrary::Softsusy>();
+}
+
+/**
+ * Selects the process-wide loop library.  Only the first call has an
+ * effect.  This function is thread-safe.
+ */
+void Loop_library::set(int new_type)
+{
+   std::lock_guard<std::mutex> lock(Loop_library::mutex_);
+
+   if (Loop_library::type_ == Loop_library::Library::Undefined) {
+      Library type = Library::Undefined;
+      Loop_library::lib_ = Loop_library::create(new_type, type);
+      if (const char* flag = std::getenv("FLEXIBLESUSY_LOOP_LIBRARY_CACHE")) {
+         Loop_library::cache_enabled_ = std::atoi(flag) != 0;
+         VERBOSE_MSG("Setting looplibrary cache using environment variable "
+                     << "FLEXIBLESUSY_LOOP_LIBRARY_CACHE=" << flag);
       }
+      Loop_library::apply_cache();
+      Loop_library::type_ = type;
+   }
+}
+
+/**
+ * Enables or disables the caching of the one- and two-point
+ * functions of the process-wide library.  If the loop library has
+ * already been set, it is wrapped into (or unwrapped from) a
+ * looplibrary::Cache.  Must not be called while loop functions are
+ * evaluated in other threads.
+ */
+void Loop_library::enable_cache(bool flag)
+{
+   std::lock_guard<std::mutex> lock(Loop_library::mutex_);
+   Loop_library::cache_enabled_ = flag;
+   Loop_library::apply_cache();
+}
+
+bool Loop_library::is_cache_enabled()
+{
+   std::lock_guard<std::mutex> lock(Loop_library::mutex_);
+   return Loop_library::cache_enabled_;
+}
+
+void Loop_library::clear_cache()
+{
+   looplibrary::Cache::clear();
+}
+
+void Loop_library::apply_cache()
+{
+   if (!Loop_library::lib_) {
+      return;
+   }
+
+   auto* cache = dynamic_cast<looplibrary::Cache*>(Loop_library::lib_.get());
+
+   if (Loop_library::cache_enabled_ && !cache) {
+      Loop_library::lib_ = std::make_unique<looplibrary::Cache>(std::move(Loop_library::lib_));
+      VERBOSE_MSG("Enabling looplibrary cache.");
+   } else if (!Loop_library::cache_enabled_ && cache) {
+      Loop_library::lib_ = cache->release();
+      VERBOSE_MSG("Disabling looplibrary cache.");
    }
 }
 
+/**
+ * Returns the type of the loop library used in the calling thread.
+ */
 Loop_library::Library Loop_library::get_type()
 {
+   if (Loop_library::context_ && !Loop_library::context_->empty()) {
+      return Loop_library::context_->get_type();
+   }
    return type_;
 }
 
+/**
+ * Returns the loop library of the context of the calling thread.  If
+ * the thread has no (or an empty) context, the process-wide loop
+ * library is returned.
+ */
 looplibrary::Loop_library_interface& Loop_library::get()
 {
+   if (Loop_library::context_ && !Loop_library::context_->empty()) {
+      return Loop_library::context_->get();
+   }
    if (Loop_library::type_ == Loop_library::Library::Undefined) {
       ERROR("Loop library should be initialized before first usage.\n"
             "Setting default library.");
@@ -124,4 +287,39 @@ looplibrary::Loop_library_interface& Loop_library::get()
    return *Loop_library::lib_;
 }
 
+Loop_library_context* Loop_library::get_context()
+{
+   return Loop_library::context_;
+}
+
+Loop_library_context* Loop_library::set_context(Loop_library_context* context)
+{
+   Loop_library_context* previous = Loop_library::context_;
+   Loop_library::context_ = context;
+   return previous;
+}
+
+/**
+ * Creates a context with a new loop library.
+ *
+ * @param new_type library type, see Loop_library::create()
+ * @param cache whether to cache the one- and two-point functions
+ */
+Loop_library_context::Loop_library_context(int new_type, bool cache)
+{
+   std::unique_ptr<looplibrary::Loop_library_interface> lib = Loop_library::create(new_type, type_);
+   if (cache) {
+      lib = std::make_unique<looplibrary::Cache>(std::move(lib));
+   }
+   lib_ = std::move(lib);
+}
+
+looplibrary::Loop_library_interface& Loop_library_context::get()
+{
+   if (!lib_) {
+      return Loop_library::get();
+   }
+   return *lib_;
+}
+
 } // namespace flexiblesusy
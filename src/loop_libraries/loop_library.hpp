@@ -20,11 +20,25 @@
 #define LOOP_LIBRARY_H
 
 #include "loop_library_interface.hpp"
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 namespace flexiblesusy
 {
 
+class Loop_library_context;
+
+/**
+ * @class Loop_library
+ * @brief provides the loop library used by the loop functions
+ *
+ * By default, the process-wide loop library is returned by get(),
+ * which is selected once by set().  A thread can select its own loop
+ * library by installing a Loop_library_context with a
+ * Loop_library_context_guard.  While the guard is alive, get()
+ * returns the library of that context in this thread.
+ */
 class Loop_library
 {
 public:
@@ -32,17 +46,81 @@ public:
    static void set(int);
    static Library get_type();
    static looplibrary::Loop_library_interface& get();
+   /// enables/disables caching of the one- and two-point functions
+   static void enable_cache(bool);
+   static bool is_cache_enabled();
+   /// removes the cached loop functions of the calling thread
+   static void clear_cache();
+   /// returns the loop library context of the calling thread (may be nullptr)
+   static Loop_library_context* get_context();
+   /// sets the loop library context of the calling thread, returns the previous one
+   static Loop_library_context* set_context(Loop_library_context*);
+   /// creates a new loop library of the given type
+   static std::unique_ptr<looplibrary::Loop_library_interface> create(int, Library&);
 
 private:
-   static Library type_;
+   static std::atomic<Library> type_;
    static std::unique_ptr<looplibrary::Loop_library_interface> lib_;
-   static void set_default();
+   static bool cache_enabled_;
+   static std::mutex mutex_;
+   static thread_local Loop_library_context* context_;
+   static void apply_cache();
 
    Loop_library() {}
    Loop_library(Loop_library const&);
    void operator=(Loop_library const&);
 };
 
+/**
+ * @class Loop_library_context
+ * @brief loop library owned by an object (e.g. a spectrum generator)
+ *
+ * A default-constructed context is empty and refers to the
+ * process-wide loop library.  Copies of a context share the same loop
+ * library object.
+ *
+ * @note The Fortran libraries (COLLIER, LoopTools, FFlite) have
+ * global state.  Therefore, all contexts (and the process-wide
+ * library) of the same Fortran type share one instance, which is
+ * initialized only once.  Only the Softsusy library can be used by
+ * several threads at the same time.
+ */
+class Loop_library_context
+{
+public:
+   Loop_library_context() = default;
+   explicit Loop_library_context(int, bool cache = false);
+
+   Loop_library::Library get_type() const { return type_; }
+   bool empty() const { return !lib_; }
+   looplibrary::Loop_library_interface& get();
+
+private:
+   Loop_library::Library type_{Loop_library::Library::Undefined};
+   std::shared_ptr<looplibrary::Loop_library_interface> lib_{};
+};
+
+/**
+ * @class Loop_library_context_guard
+ * @brief installs a loop library context in the calling thread
+ *
+ * The previous context of the thread is restored on destruction.
+ */
+class Loop_library_context_guard
+{
+public:
+   explicit Loop_library_context_guard(Loop_library_context* context)
+      : previous(Loop_library::set_context(context)) {}
+   explicit Loop_library_context_guard(Loop_library_context& context)
+      : Loop_library_context_guard(&context) {}
+   ~Loop_library_context_guard() { Loop_library::set_context(previous); }
+   Loop_library_context_guard(const Loop_library_context_guard&) = delete;
+   Loop_library_context_guard& operator=(const Loop_library_context_guard&) = delete;
+
+private:
+   Loop_library_context* previous{nullptr};
+};
+
 } // namespace flexiblesusy
 
 #endif // LOOP_LIBRARY_H
@@ -27,6 +27,7 @@
 #include "eigen_utils.hpp"
 #include "error.hpp"
 #include "ew_input.hpp"
+#include "qedqcd_cache.hpp"
 #include "string_format.hpp"
 
 #include <algorithm>
@@ -374,11 +375,111 @@ void QedQcd::toMz()
  * This function can be called multiple times, leading to the same
  * result.
  *
+ * The result is stored in the process-wide cache returned by
+ * to_cache().  If the same object (same input parameters and same
+ * running state) has been evolved before with the same arguments,
+ * the stored result is used instead of repeating the iteration.
+ *
  * @param scale target renormalization scale
  * @param precision_goal precision goal
  * @param max_iterations maximum number of iterations
  */
 void QedQcd::to(double scale, double precision_goal, int max_iterations) {
+   auto& cache = to_cache();
+   const auto key = get_cache_key(scale, precision_goal, max_iterations);
+   Eigen::ArrayXd result;
+
+   if (cache.find(key, result)) {
+      set_running_state(result);
+      return;
+   }
+
+   to_uncached(scale, precision_goal, max_iterations);
+
+   cache.add(key, get_running_state());
+}
+
+/**
+ * Evolves the object to the given scale, like run_to().  The result
+ * is stored in the process-wide cache returned by running_cache() and
+ * is re-used if the same object is evolved again with the same
+ * arguments.
+ *
+ * @param scale target renormalization scale
+ * @param eps precision of the RG running
+ */
+void QedQcd::run_to_cached(double scale, double eps)
+{
+   auto& cache = running_cache();
+   const auto key = get_cache_key(scale, eps, 0);
+   Eigen::ArrayXd result;
+
+   if (cache.find(key, result)) {
+      set_running_state(result);
+      return;
+   }
+
+   run_to(scale, eps);
+
+   cache.add(key, get_running_state());
+}
+
+/// process-wide cache of the results of to()
+flexiblesusy::QedQcd_cache& QedQcd::to_cache()
+{
+   static flexiblesusy::QedQcd_cache cache;
+   return cache;
+}
+
+/// process-wide cache of the results of run_to_cached()
+flexiblesusy::QedQcd_cache& QedQcd::running_cache()
+{
+   static flexiblesusy::QedQcd_cache cache;
+   return cache;
+}
+
+/**
+ * Returns the running state of the object, i.e. everything which is
+ * changed by to() and run_to().
+ */
+Eigen::ArrayXd QedQcd::get_running_state() const
+{
+   Eigen::ArrayXd state(a.size() + mf.size() + 2);
+   state << a, mf, mbPole, get_scale();
+   return state;
+}
+
+/// sets the running state, as returned by get_running_state()
+void QedQcd::set_running_state(const Eigen::ArrayXd& state)
+{
+   a = state.head(a.size());
+   mf = state.segment(a.size(), mf.size());
+   mbPole = state(a.size() + mf.size());
+   set_scale(state(a.size() + mf.size() + 1));
+}
+
+/**
+ * Returns the key which identifies a run in the caches: the running
+ * state, the input parameters, the RG settings and the arguments of
+ * the run.
+ */
+Eigen::ArrayXd QedQcd::get_cache_key(double scale, double eps, int max_iterations) const
+{
+   const auto state = get_running_state();
+   Eigen::ArrayXd key(state.size() + input.size() + 6);
+   key << state, input, get_loops(), get_thresholds(), get_zero_threshold(),
+      scale, eps, max_iterations;
+   return key;
+}
+
+/**
+ * Iteration of to() without the cache.
+ *
+ * @param scale target renormalization scale
+ * @param precision_goal precision goal
+ * @param max_iterations maximum number of iterations
+ */
+void QedQcd::to_uncached(double scale, double precision_goal, int max_iterations) {
    int it = 0;
    bool converged = false;
    auto qedqcd_old(get()), qedqcd_new(get());
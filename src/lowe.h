@@ -35,6 +35,10 @@
 #include <iosfwd>
 #include <Eigen/Core>
 
+namespace flexiblesusy {
+class QedQcd_cache;
+} // namespace flexiblesusy
+
 namespace softsusy {
 
 /// used to give order of quark masses stored
@@ -81,6 +85,11 @@ private:
   /// calculates pole bottom mass given alpha_s(Mb)^{MSbar} from running b mass
   double extractPoleMb(double asMb);
 
+  Eigen::ArrayXd get_running_state() const;
+  void set_running_state(const Eigen::ArrayXd&);
+  Eigen::ArrayXd get_cache_key(double, double, int) const;
+  void to_uncached(double, double, int);
+
 public:
   QedQcd();
   QedQcd(const QedQcd&) = default;
@@ -192,6 +201,12 @@ public:
   void toMz();
   /// Evolves object to given scale.
   void to(double scale, double precision_goal = 1e-5, int max_iterations = 20);
+  /// Evolves object to given scale, re-using the results of identical runs
+  void run_to_cached(double scale, double eps = -1.0);
+  /// process-wide cache of the results of to()
+  static flexiblesusy::QedQcd_cache& to_cache();
+  /// process-wide cache of the results of run_to_cached()
+  static flexiblesusy::QedQcd_cache& running_cache();
   /// guess coupling constants {alpha_1, alpha_2, alpha_3} in SM(5)
   Eigen::Array<double,3,1> guess_alpha_SM5(double scale) const;
 };
@@ -10,6 +10,7 @@ LIBFLEXI_SRC := \
 		$(DIR)/build_info.cpp \
 		$(DIR)/bvp_solver_problems.cpp \
 		$(DIR)/ckm.cpp \
+		$(DIR)/columnar_file.cpp \
 		$(DIR)/command_line_options.cpp \
 		$(DIR)/composite_convergence_tester.cpp \
 		$(DIR)/coupling_monitor.cpp \
@@ -19,6 +20,7 @@ LIBFLEXI_SRC := \
 		$(DIR)/global_thread_pool.cpp \
 		$(DIR)/gm2calc_interface.cpp \
 		$(DIR)/gsl_multimin_fminimizer.cpp \
+		$(DIR)/gsl_multiroot_fdfsolver.cpp \
 		$(DIR)/gsl_multiroot_fsolver.cpp \
 		$(DIR)/gsl_utils.cpp \
 		$(DIR)/gsl_vector.cpp \
@@ -37,6 +39,9 @@ LIBFLEXI_SRC := \
 		$(DIR)/physical_input.cpp \
 		$(DIR)/pmns.cpp \
 		$(DIR)/problems.cpp \
+		$(DIR)/profiling.cpp \
+		$(DIR)/qedqcd_cache.cpp \
+		$(DIR)/rg_trajectory.cpp \
 		$(DIR)/rkf_integrator.cpp \
 		$(DIR)/scan.cpp \
 		$(DIR)/slha_format.cpp \
@@ -49,6 +54,7 @@ LIBFLEXI_SRC := \
 		$(DIR)/threshold_corrections.cpp \
 		$(DIR)/threshold_loop_functions.cpp \
 		$(DIR)/trilog.cpp \
+		$(DIR)/warm_start_cache.cpp \
 		$(DIR)/wrappers.cpp
 
 LIBFLEXI_HDR := \
@@ -60,6 +66,7 @@ LIBFLEXI_HDR := \
 		$(DIR)/bvp_solver_problems_format_mathlink.hpp \
 		$(DIR)/cextensions.hpp \
 		$(DIR)/ckm.hpp \
+		$(DIR)/columnar_file.hpp \
 		$(DIR)/command_line_options.hpp \
 		$(DIR)/complex.hpp \
 		$(DIR)/composite_convergence_tester.hpp \
@@ -69,6 +76,7 @@ LIBFLEXI_HDR := \
 		$(DIR)/convergence_tester.hpp \
 		$(DIR)/convergence_tester_drbar.hpp \
 		$(DIR)/coupling_monitor.hpp \
+		$(DIR)/coupling_table.hpp \
 		$(DIR)/database.hpp \
 		$(DIR)/derivative.hpp \
 		$(DIR)/dilog.hpp \
@@ -86,6 +94,7 @@ LIBFLEXI_HDR := \
 		$(DIR)/gm2calc_interface.hpp \
 		$(DIR)/gsl.hpp \
 		$(DIR)/gsl_multimin_fminimizer.hpp \
+		$(DIR)/gsl_multiroot_fdfsolver.hpp \
 		$(DIR)/gsl_multiroot_fsolver.hpp \
 		$(DIR)/gsl_utils.hpp \
 		$(DIR)/gsl_vector.hpp \
@@ -102,6 +111,7 @@ LIBFLEXI_HDR := \
 		$(DIR)/mixings.hpp \
 		$(DIR)/model.hpp \
 		$(DIR)/multiindex.hpp \
+		$(DIR)/parallel_scan.hpp \
 		$(DIR)/names.hpp \
 		$(DIR)/numerics.h \
 		$(DIR)/numerics2.hpp \
@@ -114,9 +124,12 @@ LIBFLEXI_HDR := \
 		$(DIR)/pmns.hpp \
 		$(DIR)/pp_map.hpp \
 		$(DIR)/problems.hpp \
+		$(DIR)/profiling.hpp \
 		$(DIR)/problems_format_mathlink.hpp \
+		$(DIR)/qedqcd_cache.hpp \
 		$(DIR)/raii.hpp \
 		$(DIR)/rg_flow.hpp \
+		$(DIR)/rg_trajectory.hpp \
 		$(DIR)/rk.hpp \
 		$(DIR)/rkf_integrator.hpp \
 		$(DIR)/root_finder.hpp \
@@ -136,6 +149,7 @@ LIBFLEXI_HDR := \
 		$(DIR)/threshold_corrections.hpp \
 		$(DIR)/threshold_loop_functions.hpp \
 		$(DIR)/trilog.hpp \
+		$(DIR)/warm_start_cache.hpp \
 		$(DIR)/which.hpp \
 		$(DIR)/wrappers.hpp
 
@@ -201,9 +215,11 @@ endif
 LOOP_DIR := $(DIR)/loop_libraries
 
 LOOP_SRC := \
+		$(LOOP_DIR)/library_cache.cpp \
 		$(LOOP_DIR)/loop_library.cpp
 
 LOOP_HDR := \
+		$(LOOP_DIR)/library_cache.hpp \
 		$(LOOP_DIR)/loop_library.hpp \
 		$(LOOP_DIR)/loop_library_interface.hpp
 
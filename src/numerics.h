@@ -45,6 +45,15 @@ double b22bar(double p, double m1, double m2, double q) noexcept;
 
 double d1_b0(double p2, double m2a, double m2b) noexcept;
 
+/// a0 for n masses m[i] at scale q
+void a0_batch(const double* m, double q, double* result, int n) noexcept;
+/// b0 for n mass pairs (m1[i], m2[i]) at fixed momentum p and scale q
+void b0_batch(double p, const double* m1, const double* m2, double q, double* result, int n) noexcept;
+/// b1 for n mass pairs (m1[i], m2[i]) at fixed momentum p and scale q
+void b1_batch(double p, const double* m1, const double* m2, double q, double* result, int n) noexcept;
+/// b22 for n mass pairs (m1[i], m2[i]) at fixed momentum p and scale q
+void b22_batch(double p, const double* m1, const double* m2, double q, double* result, int n) noexcept;
+
 } // namespace softsusy
 
 #endif
@@ -0,0 +1,251 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef PARALLEL_SCAN_H
+#define PARALLEL_SCAN_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file parallel_scan.hpp
+ * @brief contains a driver which runs independent parameter points
+ * of a scan on multiple threads
+ */
+
+namespace flexiblesusy {
+
+/**
+ * @class Parallel_scan
+ * @brief Runs independent parameter points on a set of worker threads
+ *
+ * The point indices [0, number_of_points) are split into contiguous
+ * shards, one per worker.  Each worker processes its own shard from
+ * the front.  When a worker runs out of points it steals points from
+ * the back of the shards of the other workers, so that points with
+ * very different run times (e.g. different number of iterations)
+ * do not leave threads idle.
+ *
+ * Each worker owns a state object, created once per worker by the
+ * user-provided factory.  The state can hold everything which must
+ * not be shared between threads (spectrum generator, QedQcd, input
+ * parameters, ...).
+ *
+ * The results are passed to the output function, which is called
+ * sequentially (never concurrently), either in the order of the
+ * point indices (Output_order::input) or in the order of completion
+ * (Output_order::completion).  The output function receives the
+ * index of the point together with the result.
+ *
+ * If number_of_threads is 0 or 1, all points are processed in the
+ * calling thread.
+ *
+ * Usage:
+ * @code
+ * Parallel_scan scan(std::thread::hardware_concurrency());
+ * scan.run(points.size(),
+ *          [] () { return Worker_state(); },
+ *          [&points] (Worker_state& state, std::size_t i) { return state.run(points[i]); },
+ *          [] (std::size_t i, const Result& result) { std::cout << result << '\n'; });
+ * @endcode
+ */
+class Parallel_scan {
+public:
+   enum class Output_order { input, completion };
+
+   explicit Parallel_scan(std::size_t number_of_threads_ = std::thread::hardware_concurrency(),
+                          Output_order output_order_ = Output_order::input)
+      : number_of_threads(number_of_threads_)
+      , output_order(output_order_)
+   {}
+
+   std::size_t get_number_of_threads() const { return number_of_threads; }
+   Output_order get_output_order() const { return output_order; }
+
+   /// runs all points and passes the results to the output function
+   template <typename Make_state, typename Run, typename Output>
+   void run(std::size_t number_of_points, Make_state&& make_state, Run&& run_point, Output&& output) const;
+
+private:
+   /// queue of point indices owned by one worker
+   struct Shard {
+      std::deque<std::size_t> points{};
+      std::mutex mutex{};
+   };
+
+   /// collects results and forwards them to the output function
+   template <typename Result, typename Output>
+   class Result_collector {
+   public:
+      Result_collector(Output& output_, Output_order order_)
+         : output(output_), order(order_) {}
+
+      void add(std::size_t index, Result&& result)
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+
+         if (order == Output_order::completion) {
+            output(index, result);
+            return;
+         }
+
+         pending.emplace(index, std::move(result));
+
+         for (auto it = pending.begin();
+              it != pending.end() && it->first == next_index;
+              it = pending.erase(it), ++next_index) {
+            output(it->first, it->second);
+         }
+      }
+
+   private:
+      Output& output;
+      Output_order order;
+      std::mutex mutex{};
+      std::map<std::size_t, Result> pending{}; ///< results waiting for output
+      std::size_t next_index{0};               ///< index of next point to output
+   };
+
+   std::size_t number_of_threads{0};
+   Output_order output_order{Output_order::input};
+
+   static bool pop_own(Shard&, std::size_t&);
+   static bool steal(std::vector<Shard>&, std::size_t, std::size_t&);
+};
+
+/**
+ * Runs the parameter points with indices [0, number_of_points).
+ *
+ * @param number_of_points number of parameter points
+ * @param make_state function which returns a new worker state
+ * @param run_point function of the form Result(State&, std::size_t)
+ * which runs the parameter point with the given index
+ * @param output function of the form void(std::size_t, const Result&)
+ *
+ * If run_point throws an exception, no new points are started and
+ * the first exception is re-thrown after all workers have finished.
+ */
+template <typename Make_state, typename Run, typename Output>
+void Parallel_scan::run(
+   std::size_t number_of_points, Make_state&& make_state, Run&& run_point, Output&& output) const
+{
+   using State_t = decltype(make_state());
+   using Result_t = decltype(run_point(std::declval<State_t&>(), std::size_t{}));
+
+   const std::size_t n_workers = std::min(number_of_threads, number_of_points);
+
+   if (n_workers <= 1) {
+      auto state = make_state();
+      for (std::size_t i = 0; i < number_of_points; ++i) {
+         output(i, run_point(state, i));
+      }
+      return;
+   }
+
+   std::vector<Shard> shards(n_workers);
+
+   for (std::size_t w = 0; w < n_workers; ++w) {
+      const std::size_t begin = w * number_of_points / n_workers;
+      const std::size_t end = (w + 1) * number_of_points / n_workers;
+      for (std::size_t i = begin; i < end; ++i) {
+         shards[w].points.push_back(i);
+      }
+   }
+
+   Result_collector<Result_t, typename std::remove_reference<Output>::type>
+      collector(output, output_order);
+   std::atomic<bool> abort{false};
+   std::exception_ptr first_exception{};
+   std::mutex exception_mutex;
+
+   const auto worker = [&] (std::size_t w) {
+      try {
+         auto state = make_state();
+         std::size_t i = 0;
+         while (!abort && (pop_own(shards[w], i) || steal(shards, w, i))) {
+            collector.add(i, run_point(state, i));
+         }
+      } catch (...) {
+         std::lock_guard<std::mutex> lock(exception_mutex);
+         if (!first_exception) {
+            first_exception = std::current_exception();
+         }
+         abort = true;
+      }
+   };
+
+   std::vector<std::thread> threads;
+   threads.reserve(n_workers - 1);
+
+   for (std::size_t w = 1; w < n_workers; ++w) {
+      threads.emplace_back(worker, w);
+   }
+
+   worker(0);
+
+   for (auto& t: threads) {
+      t.join();
+   }
+
+   if (first_exception) {
+      std::rethrow_exception(first_exception);
+   }
+}
+
+/// takes the next point from the front of the worker's own shard
+inline bool Parallel_scan::pop_own(Shard& shard, std::size_t& index)
+{
+   std::lock_guard<std::mutex> lock(shard.mutex);
+   if (shard.points.empty()) {
+      return false;
+   }
+   index = shard.points.front();
+   shard.points.pop_front();
+   return true;
+}
+
+/// takes a point from the back of the shard of another worker
+inline bool Parallel_scan::steal(std::vector<Shard>& shards, std::size_t thief, std::size_t& index)
+{
+   const std::size_t n = shards.size();
+
+   for (std::size_t k = 1; k < n; ++k) {
+      Shard& victim = shards[(thief + k) % n];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.points.empty()) {
+         index = victim.points.back();
+         victim.points.pop_back();
+         return true;
+      }
+   }
+
+   return false;
+}
+
+} // namespace flexiblesusy
+
+#endif
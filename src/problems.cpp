@@ -201,6 +201,56 @@ std::vector<std::string> Problems::get_warning_strings() const
    return strings;
 }
 
+/**
+ * Returns the names of the individual problem and warning flags in
+ * the order of get_flags().  For each particle there is one flag for
+ * an imprecise mass, a running tachyon, a pole tachyon and a failed
+ * pole mass convergence, e.g. "PoleTachyon(hh)".
+ */
+std::vector<std::string> Problems::get_flag_names() const
+{
+   std::vector<std::string> names;
+   const auto n_particles = particle_names->size();
+
+   for (const auto& flag: {"BadMass", "RunningTachyon", "PoleTachyon", "NoPoleMassConvergence"}) {
+      for (int i = 0; i < n_particles; ++i) {
+         names.emplace_back(std::string(flag) + '(' + particle_names->get(i) + ')');
+      }
+   }
+
+   names.insert(names.end(), {
+      "NoEWSB", "NoEWSBTreeLevel", "NonPerturbative",
+      "NoSinThetaWConvergence", "Thrown", "NonPerturbativeParameters"
+   });
+
+   return names;
+}
+
+/**
+ * Returns the individual problem and warning flags (0 or 1) in the
+ * order of get_flag_names().  The last entry is the number of
+ * non-perturbative parameters.
+ */
+std::vector<double> Problems::get_flags() const
+{
+   std::vector<double> flags;
+   flags.reserve(4*bad_masses.size() + 6);
+
+   for (const auto* v: {&bad_masses, &running_tachyons, &pole_tachyons, &failed_pole_mass_convergence}) {
+      for (const auto f: *v) {
+         flags.push_back(f ? 1. : 0.);
+      }
+   }
+
+   flags.insert(flags.end(), {
+      static_cast<double>(failed_ewsb), static_cast<double>(failed_ewsb_tree_level),
+      static_cast<double>(non_perturbative), static_cast<double>(failed_sinThetaW_convergence),
+      static_cast<double>(have_thrown()), static_cast<double>(non_pert_pars.size())
+   });
+
+   return flags;
+}
+
 std::string Problems::get_problem_string(const std::string& sep) const
 {
    return concat(get_problem_strings(), sep);
@@ -86,6 +86,8 @@ public:
    std::vector<std::string> get_warning_strings() const;
    std::string get_problem_string(const std::string& sep = "\n") const;
    std::string get_warning_string(const std::string& sep = "\n") const;
+   std::vector<std::string> get_flag_names() const; ///< names of the individual flags
+   std::vector<double> get_flags() const;           ///< individual flags, see get_flag_names()
    std::string get_particle_name(int) const;  ///< returns particle name
    std::string get_parameter_name(int) const; ///< returns parameter name
    void print_problems() const;
@@ -0,0 +1,414 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "profiling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+
+namespace flexiblesusy {
+namespace profiling {
+
+constexpr int Scan_profile::bins_per_decade;
+constexpr double Scan_profile::min_time;
+constexpr int Scan_profile::number_of_decades;
+constexpr int Scan_profile::number_of_bins;
+
+namespace {
+
+/// returns string as quoted JSON string
+std::string json_quote(const std::string& str)
+{
+   std::string result("\"");
+
+   for (const char c: str) {
+      switch (c) {
+      case '"':  result += "\\\""; break;
+      case '\\': result += "\\\\"; break;
+      case '\n': result += "\\n"; break;
+      case '\t': result += "\\t"; break;
+      default:   result += c; break;
+      }
+   }
+
+   return result + '"';
+}
+
+/// returns string in which newlines are replaced by spaces
+std::string slha_comment(std::string str)
+{
+   std::replace(str.begin(), str.end(), '\n', ' ');
+   return str;
+}
+
+/// merged profiles of all threads
+struct Process_profile {
+   std::mutex mutex{};
+   Profile profile{};
+};
+
+Process_profile& process_profile()
+{
+   static Process_profile profile;
+   return profile;
+}
+
+} // anonymous namespace
+
+/**
+ * Adds the time of one call to the given region.
+ *
+ * @param name name of the region
+ * @param seconds time in seconds
+ */
+void Profile::add_time(const char* name, double seconds)
+{
+   auto it = regions.find(name);
+
+   if (it == regions.end()) {
+      it = regions.emplace(name, Region()).first;
+   }
+
+   it->second.calls++;
+   it->second.seconds += seconds;
+}
+
+/**
+ * Increases the counter with the given name.
+ *
+ * @param name name of the counter
+ * @param n increment
+ */
+void Profile::add_count(const char* name, long long n)
+{
+   auto it = counters.find(name);
+
+   if (it == counters.end()) {
+      it = counters.emplace(name, 0).first;
+   }
+
+   it->second += n;
+}
+
+/**
+ * Adds the timings and counters of another profile.
+ *
+ * @param other profile
+ */
+void Profile::merge(const Profile& other)
+{
+   for (const auto& r: other.regions) {
+      auto& region = regions[r.first];
+      region.calls += r.second.calls;
+      region.seconds += r.second.seconds;
+   }
+
+   for (const auto& c: other.counters) {
+      counters[c.first] += c.second;
+   }
+}
+
+void Profile::clear()
+{
+   regions.clear();
+   counters.clear();
+}
+
+/**
+ * Returns the profile as JSON object of the form
+ *
+ * @code
+ * {"regions": {"name": {"calls": 1, "seconds": 0.1}, ...},
+ *  "counters": {"name": 1, ...}}
+ * @endcode
+ */
+std::string Profile::to_json() const
+{
+   std::ostringstream ostr;
+   ostr << std::setprecision(8);
+
+   ostr << "{\"regions\": {";
+   for (auto it = regions.cbegin(); it != regions.cend(); ++it) {
+      if (it != regions.cbegin()) {
+         ostr << ", ";
+      }
+      ostr << json_quote(it->first) << ": {\"calls\": " << it->second.calls
+           << ", \"seconds\": " << it->second.seconds << '}';
+   }
+   ostr << "}, \"counters\": {";
+   for (auto it = counters.cbegin(); it != counters.cend(); ++it) {
+      if (it != counters.cbegin()) {
+         ostr << ", ";
+      }
+      ostr << json_quote(it->first) << ": " << it->second;
+   }
+   ostr << "}}";
+
+   return ostr.str();
+}
+
+/**
+ * Returns the profile as SLHA block.  For each region i the block
+ * contains the entries (i,1) = number of calls and (i,2) = time in
+ * seconds.  Counters follow the regions, with (i,1) = counter value.
+ *
+ * @param block_name name of the block
+ */
+std::string Profile::to_slha_block(const std::string& block_name) const
+{
+   std::ostringstream ostr;
+   int i = 1;
+
+   ostr << "Block " << block_name << '\n';
+
+   for (const auto& r: regions) {
+      ostr << std::setw(5) << i << std::setw(5) << 1 << "   "
+           << std::setw(16) << r.second.calls << "   # "
+           << slha_comment(r.first) << " [calls]\n";
+      ostr << std::setw(5) << i << std::setw(5) << 2 << "   "
+           << std::setw(16) << std::scientific << std::setprecision(8)
+           << r.second.seconds << std::defaultfloat << "   # "
+           << slha_comment(r.first) << " [s]\n";
+      i++;
+   }
+
+   for (const auto& c: counters) {
+      ostr << std::setw(5) << i << std::setw(5) << 1 << "   "
+           << std::setw(16) << c.second << "   # "
+           << slha_comment(c.first) << '\n';
+      i++;
+   }
+
+   return ostr.str();
+}
+
+Profile& thread_profile()
+{
+   thread_local Profile profile;
+   return profile;
+}
+
+/**
+ * Merges the profile of the current thread into the process-wide
+ * profile and clears the profile of the current thread.  This
+ * function is thread-safe.
+ */
+void merge_thread_profile()
+{
+   Profile& profile = thread_profile();
+
+   if (profile.empty()) {
+      return;
+   }
+
+   auto& process = process_profile();
+   {
+      std::lock_guard<std::mutex> lock(process.mutex);
+      process.profile.merge(profile);
+   }
+
+   profile.clear();
+}
+
+/**
+ * Returns the process-wide profile, i.e. the merged profiles of all
+ * threads.  The profiles of threads which have not called
+ * merge_thread_profile() (yet) are not included.  This function is
+ * thread-safe.
+ */
+Profile get_process_profile()
+{
+   auto& process = process_profile();
+   std::lock_guard<std::mutex> lock(process.mutex);
+   return process.profile;
+}
+
+void clear_process_profile()
+{
+   auto& process = process_profile();
+   std::lock_guard<std::mutex> lock(process.mutex);
+   process.profile.clear();
+}
+
+Scoped_timer::~Scoped_timer()
+{
+   const std::chrono::duration<double> elapsed = Clock::now() - start;
+   thread_profile().add_time(name, elapsed.count());
+}
+
+/**
+ * Adds the profile of a parameter point.
+ *
+ * @param profile profile of the parameter point
+ */
+void Scan_profile::add(const Profile& profile)
+{
+   number_of_points++;
+
+   for (const auto& r: profile.get_regions()) {
+      auto& h = histograms[r.first];
+      const double t = r.second.seconds;
+      h.min = h.points == 0 ? t : std::min(h.min, t);
+      h.max = h.points == 0 ? t : std::max(h.max, t);
+      h.points++;
+      h.calls += r.second.calls;
+      h.seconds += t;
+      h.bins[get_bin(t)]++;
+   }
+
+   for (const auto& c: profile.get_counters()) {
+      auto& counter = counters[c.first];
+      counter.max = counter.total == 0 ? c.second : std::max(counter.max, c.second);
+      counter.total += c.second;
+   }
+}
+
+void Scan_profile::clear()
+{
+   number_of_points = 0;
+   histograms.clear();
+   counters.clear();
+}
+
+/**
+ * Returns the lower edge of the given bin.  Bin 0 is the underflow
+ * bin, bin number_of_bins - 1 is the overflow bin.
+ *
+ * @param bin bin index
+ * @return lower edge in seconds
+ */
+double Scan_profile::get_lower_bin_edge(int bin)
+{
+   if (bin <= 0) {
+      return 0.;
+   }
+
+   return min_time * std::pow(10., static_cast<double>(bin - 1) / bins_per_decade);
+}
+
+/**
+ * Returns the index of the bin which contains the given time.
+ *
+ * @param seconds time in seconds
+ * @return bin index
+ */
+int Scan_profile::get_bin(double seconds)
+{
+   if (!(seconds >= min_time)) {
+      return 0;
+   }
+
+   const int bin = 1 + static_cast<int>(std::floor(bins_per_decade * std::log10(seconds / min_time)));
+
+   return std::min(bin, number_of_bins - 1);
+}
+
+/**
+ * Prints a table with the total, mean, minimum and maximum time per
+ * point of each region, followed by the non-empty histogram bins.
+ *
+ * @param ostr output stream
+ */
+void Scan_profile::print(std::ostream& ostr) const
+{
+   const auto flags = ostr.flags();
+   const auto precision = ostr.precision();
+
+   ostr << "Profile of " << number_of_points << " points:\n";
+   ostr << std::scientific << std::setprecision(3);
+
+   for (const auto& h: histograms) {
+      const auto& hist = h.second;
+      ostr << "  " << h.first << ": "
+           << hist.points << " points, "
+           << hist.calls << " calls, total = " << hist.seconds << " s"
+           << ", mean = " << hist.seconds / hist.points << " s"
+           << ", min = " << hist.min << " s"
+           << ", max = " << hist.max << " s\n";
+      for (int b = 0; b < number_of_bins; b++) {
+         if (hist.bins[b] == 0) {
+            continue;
+         }
+         ostr << "     [" << get_lower_bin_edge(b) << ", ";
+         if (b + 1 < number_of_bins) {
+            ostr << get_lower_bin_edge(b + 1);
+         } else {
+            ostr << "inf";
+         }
+         ostr << ") s: " << hist.bins[b] << '\n';
+      }
+   }
+
+   for (const auto& c: counters) {
+      ostr << "  " << c.first << ": total = " << c.second.total
+           << ", max = " << c.second.max << '\n';
+   }
+
+   ostr.flags(flags);
+   ostr.precision(precision);
+}
+
+/**
+ * Returns the aggregated profile as JSON object.  The histogram bins
+ * are given together with their lower edges (in seconds).
+ */
+std::string Scan_profile::to_json() const
+{
+   std::ostringstream ostr;
+   ostr << std::setprecision(8);
+
+   ostr << "{\"points\": " << number_of_points << ", \"bin_edges\": [";
+   for (int b = 0; b < number_of_bins; b++) {
+      ostr << (b == 0 ? "" : ", ") << get_lower_bin_edge(b);
+   }
+   ostr << "], \"regions\": {";
+   for (auto it = histograms.cbegin(); it != histograms.cend(); ++it) {
+      const auto& hist = it->second;
+      if (it != histograms.cbegin()) {
+         ostr << ", ";
+      }
+      ostr << json_quote(it->first) << ": {\"points\": " << hist.points
+           << ", \"calls\": " << hist.calls
+           << ", \"seconds\": " << hist.seconds
+           << ", \"min\": " << hist.min
+           << ", \"max\": " << hist.max
+           << ", \"histogram\": [";
+      for (int b = 0; b < number_of_bins; b++) {
+         ostr << (b == 0 ? "" : ", ") << hist.bins[b];
+      }
+      ostr << "]}";
+   }
+   ostr << "}, \"counters\": {";
+   for (auto it = counters.cbegin(); it != counters.cend(); ++it) {
+      if (it != counters.cbegin()) {
+         ostr << ", ";
+      }
+      ostr << json_quote(it->first) << ": {\"total\": " << it->second.total
+           << ", \"max\": " << it->second.max << '}';
+   }
+   ostr << "}}";
+
+   return ostr.str();
+}
+
+} // namespace profiling
+} // namespace flexiblesusy
@@ -0,0 +1,203 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef PROFILING_H
+#define PROFILING_H
+
+#include "config.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+
+/**
+ * @file profiling.hpp
+ * @brief timers and counters to measure where the time of a
+ * spectrum generator run goes
+ *
+ * The following macros are available:
+ *
+ * PROFILE_SCOPE(name)     measures the time until the end of the
+ *                         enclosing scope
+ * PROFILE_COUNT(name, n)  increases the counter with the given name by n
+ *
+ * The timings and counters are collected in a Profile object, which
+ * is local to the current thread, see thread_profile().  A thread can
+ * merge its profile into the process-wide profile with
+ * merge_thread_profile(), which is done by the threads of a
+ * Thread_pool after each task.  The macros expand to nothing unless
+ * ENABLE_PROFILING is defined in config.h, which is controlled by the
+ * configure option --enable-profiling.
+ */
+
+namespace flexiblesusy {
+namespace profiling {
+
+/// accumulated time and number of calls of an instrumented region
+struct Region {
+   long long calls{0};  ///< number of calls
+   double seconds{0.};  ///< total time in seconds
+};
+
+/**
+ * @class Profile
+ * @brief timings and counters of one parameter point
+ */
+class Profile {
+public:
+   using Regions = std::map<std::string, Region, std::less<>>;
+   using Counters = std::map<std::string, long long, std::less<>>;
+
+   /// add time (in seconds) of one call of a region
+   void add_time(const char*, double);
+   /// increase counter
+   void add_count(const char*, long long);
+   /// add timings and counters of another profile
+   void merge(const Profile&);
+   /// delete all timings and counters
+   void clear();
+   bool empty() const { return regions.empty() && counters.empty(); }
+   const Regions& get_regions() const { return regions; }
+   const Counters& get_counters() const { return counters; }
+
+   /// returns profile as JSON object
+   std::string to_json() const;
+   /// returns profile as SLHA block
+   std::string to_slha_block(const std::string& block_name = "FlexibleSUSYProfile") const;
+
+private:
+   Regions regions{};   ///< timings of instrumented regions
+   Counters counters{}; ///< counters
+};
+
+/// returns the profile of the current thread
+Profile& thread_profile();
+/// merges the profile of the current thread into the process-wide profile and clears it
+void merge_thread_profile();
+/// returns the process-wide profile
+Profile get_process_profile();
+/// clears the process-wide profile
+void clear_process_profile();
+
+/**
+ * @class Scoped_timer
+ * @brief adds the time between construction and destruction to the
+ * profile of the current thread
+ */
+class Scoped_timer {
+public:
+   explicit Scoped_timer(const char* name_)
+      : name(name_), start(Clock::now()) {}
+   Scoped_timer(const Scoped_timer&) = delete;
+   Scoped_timer(Scoped_timer&&) = delete;
+   ~Scoped_timer();
+   Scoped_timer& operator=(const Scoped_timer&) = delete;
+   Scoped_timer& operator=(Scoped_timer&&) = delete;
+
+private:
+   using Clock = std::chrono::steady_clock;
+   const char* name{nullptr};  ///< name of the region
+   Clock::time_point start{};  ///< start time
+};
+
+/**
+ * @class Scan_profile
+ * @brief aggregates the profiles of the points of a scan
+ *
+ * For each region the total time per point is filled into a
+ * histogram with logarithmic bins (four bins per decade between
+ * 1 microsecond and 1000 seconds, plus underflow and overflow bins).
+ * For each counter the total and the maximum over the points are
+ * stored.
+ *
+ * The profile of a point is the thread profile of the thread that
+ * calculated the point.  The work of the point done on the threads
+ * of a Thread_pool is not included.
+ */
+class Scan_profile {
+public:
+   static constexpr int bins_per_decade = 4;
+   static constexpr double min_time = 1e-6; ///< lower edge of first bin (in seconds)
+   static constexpr int number_of_decades = 9;
+   static constexpr int number_of_bins = bins_per_decade*number_of_decades + 2;
+
+   /// histogram of the time per point of a region
+   struct Histogram {
+      std::array<long long, number_of_bins> bins{}; ///< underflow, bins, overflow
+      long long points{0};  ///< number of points with this region
+      long long calls{0};   ///< total number of calls
+      double seconds{0.};   ///< total time in seconds
+      double min{0.};       ///< minimum time per point
+      double max{0.};       ///< maximum time per point
+   };
+
+   /// aggregated counter
+   struct Counter {
+      long long total{0};   ///< sum over all points
+      long long max{0};     ///< maximum of a point
+   };
+
+   /// add profile of a parameter point
+   void add(const Profile&);
+   /// delete all data
+   void clear();
+   std::size_t get_number_of_points() const { return number_of_points; }
+   const std::map<std::string, Histogram>& get_histograms() const { return histograms; }
+   const std::map<std::string, Counter>& get_counters() const { return counters; }
+
+   /// returns lower edge of bin (in seconds)
+   static double get_lower_bin_edge(int);
+   /// returns bin index of time (in seconds)
+   static int get_bin(double);
+
+   /// print summary table with histograms
+   void print(std::ostream&) const;
+   /// returns aggregated profile as JSON object
+   std::string to_json() const;
+
+private:
+   std::size_t number_of_points{0};
+   std::map<std::string, Histogram> histograms{};
+   std::map<std::string, Counter> counters{};
+};
+
+} // namespace profiling
+} // namespace flexiblesusy
+
+#define PROFILING_CONCAT_IMPL(a, b) a##b
+#define PROFILING_CONCAT(a, b) PROFILING_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_PROFILING
+#define PROFILE_SCOPE(name)                                                    \
+   const flexiblesusy::profiling::Scoped_timer PROFILING_CONCAT(              \
+      profile_scope_, __LINE__)(name)
+#define PROFILE_COUNT(name, n)                                                 \
+   flexiblesusy::profiling::thread_profile().add_count(name, n)
+#define PROFILE_MERGE_THREAD()                                                 \
+   flexiblesusy::profiling::merge_thread_profile()
+#else
+#define PROFILE_SCOPE(name) do {} while (false)
+#define PROFILE_COUNT(name, n) do {} while (false)
+#define PROFILE_MERGE_THREAD() do {} while (false)
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "qedqcd_cache.hpp"
+
+namespace flexiblesusy {
+
+/**
+ * Stores the result of a run.  If the cache is full, the oldest
+ * result is removed.
+ *
+ * @param key state of the QedQcd object and arguments of the run
+ * @param value state of the QedQcd object after the run
+ */
+void QedQcd_cache::add(const Eigen::ArrayXd& key, const Eigen::ArrayXd& value)
+{
+   if (!enabled) {
+      return;
+   }
+
+   std::lock_guard<std::mutex> lock(mutex);
+
+   if (capacity == 0) {
+      return;
+   }
+
+   while (entries.size() >= capacity) {
+      entries.pop_front();
+   }
+
+   entries.push_back(Entry{key, value});
+}
+
+void QedQcd_cache::clear()
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   entries.clear();
+   hits = 0;
+   misses = 0;
+}
+
+/**
+ * Looks up the result of a run with the given key.
+ *
+ * @param key state of the QedQcd object and arguments of the run
+ * @param value state of the QedQcd object after the run (output)
+ *
+ * @return true if the result has been found, false otherwise
+ */
+bool QedQcd_cache::find(const Eigen::ArrayXd& key, Eigen::ArrayXd& value) const
+{
+   if (!enabled) {
+      return false;
+   }
+
+   std::lock_guard<std::mutex> lock(mutex);
+
+   // search from the most recent entry
+   for (auto it = entries.crbegin(); it != entries.crend(); ++it) {
+      if (it->key.size() == key.size() && (it->key == key).all()) {
+         value = it->value;
+         hits++;
+         return true;
+      }
+   }
+
+   misses++;
+
+   return false;
+}
+
+std::size_t QedQcd_cache::size() const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   return entries.size();
+}
+
+std::size_t QedQcd_cache::get_capacity() const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   return capacity;
+}
+
+/**
+ * Sets the maximum number of stored results.  If more results are
+ * stored, the oldest ones are removed.
+ *
+ * @param capacity_ maximum number of stored results
+ */
+void QedQcd_cache::set_capacity(std::size_t capacity_)
+{
+   std::lock_guard<std::mutex> lock(mutex);
+
+   capacity = capacity_;
+
+   while (entries.size() > capacity) {
+      entries.pop_front();
+   }
+}
+
+} // namespace flexiblesusy
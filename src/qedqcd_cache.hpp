@@ -0,0 +1,81 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef QEDQCD_CACHE_H
+#define QEDQCD_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+#include <Eigen/Core>
+
+namespace flexiblesusy {
+
+/**
+ * @class QedQcd_cache
+ * @brief thread-safe memo of the results of QedQcd runs
+ *
+ * The cache maps a key, which contains the complete state of a
+ * QedQcd object together with the arguments of the run, to the state
+ * of the object after the run.  Keys are compared exactly, so that a
+ * stored result is identical to the one of a repeated run.  In a
+ * scan, where the Standard Model input parameters are the same for
+ * all points, the runs of the low-energy data are done only once.
+ *
+ * If the cache is full, the oldest entry is removed.  All member
+ * functions may be called concurrently.
+ */
+class QedQcd_cache {
+public:
+   explicit QedQcd_cache(std::size_t capacity_ = 100) : capacity(capacity_) {}
+
+   /// store result of a run with the given key
+   void add(const Eigen::ArrayXd&, const Eigen::ArrayXd&);
+   /// delete all stored results and reset the statistics
+   void clear();
+   /// looks up the result of a run with the given key
+   bool find(const Eigen::ArrayXd&, Eigen::ArrayXd&) const;
+   /// returns number of stored results
+   std::size_t size() const;
+
+   std::size_t get_capacity() const;
+   std::size_t get_hits() const { return hits; }
+   std::size_t get_misses() const { return misses; }
+   bool is_enabled() const { return enabled; }
+   void set_capacity(std::size_t);
+   void set_enabled(bool e) { enabled = e; }
+
+private:
+   struct Entry {
+      Eigen::ArrayXd key{};
+      Eigen::ArrayXd value{};
+   };
+
+   mutable std::mutex mutex{};
+   std::size_t capacity{100};               ///< maximum number of stored results
+   std::deque<Entry> entries{};             ///< stored results (oldest first)
+   std::atomic<bool> enabled{true};         ///< enable/disable the cache
+   mutable std::atomic<std::size_t> hits{0};   ///< number of successful look-ups
+   mutable std::atomic<std::size_t> misses{0}; ///< number of failed look-ups
+};
+
+} // namespace flexiblesusy
+
+#endif
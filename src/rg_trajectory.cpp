@@ -0,0 +1,181 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+/**
+ * @file rg_trajectory.cpp
+ * @brief contains the implementation of class RG_trajectory
+ */
+
+#include "rg_trajectory.hpp"
+#include "error.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+
+namespace flexiblesusy {
+
+namespace {
+
+/// tolerance for scales at the boundary of the trajectory in log(scale)
+const double boundary_tolerance = 1e-10;
+
+} // anonymous namespace
+
+void RG_trajectory::clear()
+{
+   t.clear();
+   y.clear();
+   dydt.clear();
+   d2ydt2.clear();
+}
+
+/**
+ * Adds a node to the trajectory.
+ *
+ * @param t_ logarithm of the renormalization scale
+ * @param y_ parameters at t_
+ * @param dydt_ beta functions at t_
+ * @param d2ydt2_ derivatives of the beta functions w.r.t. t at t_
+ */
+void RG_trajectory::add(double t_, const Eigen::ArrayXd& y_,
+                        const Eigen::ArrayXd& dydt_, const Eigen::ArrayXd& d2ydt2_)
+{
+   if (y_.size() != dydt_.size() || y_.size() != d2ydt2_.size()) {
+      throw SetupError("RG_trajectory: parameters and beta functions differ in size");
+   }
+
+   if (!t.empty()) {
+      if (y_.size() != y.front().size()) {
+         throw SetupError("RG_trajectory: number of parameters changed");
+      }
+      if (std::fabs(t_ - t.back()) <= boundary_tolerance) {
+         y.back() = y_;
+         dydt.back() = dydt_;
+         d2ydt2.back() = d2ydt2_;
+         return;
+      }
+      if (t.size() >= 2 && (t_ > t.back()) != is_increasing()) {
+         throw SetupError("RG_trajectory: nodes must be added in monotonic order");
+      }
+   }
+
+   t.push_back(t_);
+   y.push_back(y_);
+   dydt.push_back(dydt_);
+   d2ydt2.push_back(d2ydt2_);
+}
+
+double RG_trajectory::get_min_scale() const
+{
+   if (t.empty()) {
+      return 0.;
+   }
+   return std::exp(std::min(t.front(), t.back()));
+}
+
+double RG_trajectory::get_max_scale() const
+{
+   if (t.empty()) {
+      return 0.;
+   }
+   return std::exp(std::max(t.front(), t.back()));
+}
+
+bool RG_trajectory::covers_log(double lq) const
+{
+   if (t.empty()) {
+      return false;
+   }
+
+   const double lo = std::min(t.front(), t.back());
+   const double hi = std::max(t.front(), t.back());
+
+   return lq >= lo - boundary_tolerance && lq <= hi + boundary_tolerance;
+}
+
+bool RG_trajectory::covers(double scale) const
+{
+   return scale > 0. && covers_log(std::log(scale));
+}
+
+/**
+ * Returns the index i of the interval [t[i], t[i+1]] which contains
+ * lq.  Assumes that there are at least two nodes.
+ */
+std::size_t RG_trajectory::find_interval(double lq) const
+{
+   const auto it = is_increasing()
+      ? std::upper_bound(t.cbegin(), t.cend(), lq)
+      : std::upper_bound(t.cbegin(), t.cend(), lq, std::greater<double>());
+
+   const std::size_t i = it == t.cbegin() ? 0 : (it - t.cbegin()) - 1;
+
+   return std::min(i, t.size() - 2);
+}
+
+Eigen::ArrayXd RG_trajectory::get(double scale) const
+{
+   Eigen::ArrayXd pars;
+   get_into(scale, pars);
+   return pars;
+}
+
+/**
+ * Interpolates the parameters at the given scale.
+ *
+ * @param scale renormalization scale
+ * @param pars array to write the parameters to (resized if necessary)
+ */
+void RG_trajectory::get_into(double scale, Eigen::ArrayXd& pars) const
+{
+   if (!covers(scale)) {
+      throw OutOfBoundsError(
+         "RG_trajectory: scale " + std::to_string(scale) +
+         " is outside of the recorded interval [" +
+         std::to_string(get_min_scale()) + ", " +
+         std::to_string(get_max_scale()) + "]");
+   }
+
+   if (t.size() == 1) {
+      pars = y.front();
+      return;
+   }
+
+   const double lq = std::log(scale);
+   const std::size_t i = find_interval(lq);
+   const double h = t[i + 1] - t[i];
+   const double s = std::min(std::max((lq - t[i]) / h, 0.), 1.);
+   const double s2 = s * s;
+   const double s3 = s2 * s;
+   const double s4 = s3 * s;
+   const double s5 = s4 * s;
+
+   // quintic Hermite basis functions
+   const double h0 = 1 - 10 * s3 + 15 * s4 - 6 * s5;
+   const double h1 = s - 6 * s3 + 8 * s4 - 3 * s5;
+   const double h2 = 0.5 * (s2 - 3 * s3 + 3 * s4 - s5);
+   const double h3 = 0.5 * (s3 - 2 * s4 + s5);
+   const double h4 = -4 * s3 + 7 * s4 - 3 * s5;
+   const double h5 = 10 * s3 - 15 * s4 + 6 * s5;
+
+   pars = h0 * y[i] + (h1 * h) * dydt[i] + (h2 * h * h) * d2ydt2[i]
+      + (h3 * h * h) * d2ydt2[i + 1] + (h4 * h) * dydt[i + 1] + h5 * y[i + 1];
+}
+
+} // namespace flexiblesusy
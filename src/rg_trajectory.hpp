@@ -0,0 +1,77 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+#ifndef RG_TRAJECTORY_H
+#define RG_TRAJECTORY_H
+
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace flexiblesusy {
+
+/**
+ * @class RG_trajectory
+ * @brief records an RG flow and interpolates it between the steps
+ *
+ * The trajectory stores the parameters together with their first and
+ * second derivatives w.r.t. t = log(scale) at the points (nodes) of
+ * an adaptive Runge-Kutta integration, see
+ * Beta_function::run_and_record().  The parameters at an arbitrary
+ * scale within the covered interval are obtained by quintic Hermite
+ * interpolation in t between the two neighbouring nodes, without new
+ * beta function evaluations.
+ *
+ * The nodes must be added in a strictly monotonic order of t (either
+ * increasing or decreasing).
+ */
+class RG_trajectory {
+public:
+   /// delete all nodes
+   void clear();
+   /// returns true if there are no nodes
+   bool empty() const { return t.empty(); }
+   /// returns number of nodes
+   std::size_t size() const { return t.size(); }
+   /// add node at t = log(scale) with parameters y and derivatives dy/dt, d^2y/dt^2
+   void add(double, const Eigen::ArrayXd&, const Eigen::ArrayXd&, const Eigen::ArrayXd&);
+   /// returns true if the given scale lies within the recorded interval
+   bool covers(double) const;
+   /// returns smallest scale of the trajectory
+   double get_min_scale() const;
+   /// returns largest scale of the trajectory
+   double get_max_scale() const;
+   /// returns parameters at the given scale
+   Eigen::ArrayXd get(double) const;
+   /// writes parameters at the given scale into the given array
+   void get_into(double, Eigen::ArrayXd&) const;
+
+private:
+   std::vector<double> t{};             ///< log(scale) at the nodes
+   std::vector<Eigen::ArrayXd> y{};     ///< parameters at the nodes
+   std::vector<Eigen::ArrayXd> dydt{};  ///< beta functions at the nodes
+   std::vector<Eigen::ArrayXd> d2ydt2{};///< derivatives of the beta functions at the nodes
+
+   bool is_increasing() const { return t.size() < 2 || t.back() > t.front(); }
+   bool covers_log(double) const;
+   std::size_t find_interval(double) const;
+};
+
+} // namespace flexiblesusy
+
+#endif
@@ -30,6 +30,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <initializer_list>
+#include <type_traits>
 
 #include "logger.hpp"
 #include "error.hpp"
@@ -201,6 +203,225 @@ void integrateOdes(ArrayType& ystart, double from, double to, double eps,
    throw NonPerturbativeRunningError(std::exp(x), max_step_dir, y(max_step_dir));
 }
 
+/**
+ * @class Workspace
+ * @brief Preallocated buffers for the allocation-free Runge-Kutta
+ * routines
+ *
+ * The buffers are scratch space only.  Therefore, copying or moving a
+ * Workspace yields an empty Workspace, which is resized on first use.
+ * The buffer ystart is not used (nor resized) by the integration
+ * routines and may be used by the caller to hold the initial/final
+ * values.
+ */
+template <typename ArrayType>
+class Workspace {
+public:
+   Workspace() = default;
+   explicit Workspace(int n) { resize(n); }
+   Workspace(const Workspace&) {}
+   Workspace(Workspace&&) noexcept {}
+   ~Workspace() = default;
+   Workspace& operator=(const Workspace&) { return *this; }
+   Workspace& operator=(Workspace&&) noexcept { return *this; }
+
+   /// resizes all buffers except ystart (no-op if the size does not change)
+   void resize(int n) {
+      if (y.size() == n) {
+         return;
+      }
+      for (auto a: {&y, &dydx, &yscal, &yout, &yerr, &ytemp,
+                    &ak2, &ak3, &ak4, &ak5, &ak6}) {
+         a->resize(n);
+      }
+   }
+
+   int size() const { return y.size(); }
+
+   ArrayType ystart{}, y{}, dydx{}, yscal{}, yout{}, yerr{}, ytemp{};
+   ArrayType ak2{}, ak3{}, ak4{}, ak5{}, ak6{};
+};
+
+/// A single step of Runge Kutta (5th order), input: y and dydx
+/// (derivative of y), x is independent variable. yout is value after
+/// step.  derivs(x, y, dydx) is a user-supplied function, which writes
+/// the derivatives into dydx.  Uses the buffers from the workspace
+/// instead of allocating temporaries.
+template <typename ArrayType, typename Derivs>
+void rungeKuttaStepInPlace(const ArrayType& y, const ArrayType& dydx, double x,
+                    double h, ArrayType& yout, ArrayType& yerr, Derivs& derivs,
+                    Workspace<ArrayType>& ws)
+{
+   const double a2 = 0.2;
+   const double a3 = 0.3;
+   const double a4 = 0.6;
+   const double a5 = 1.0;
+   const double a6 = 0.875;
+   const double b21 = 0.2;
+   const double b31 = 3.0 / 40.0;
+   const double b32 = 9.0 / 40.0;
+   const double b41 = 0.3;
+   const double b42 = -0.9;
+   const double b43 = 1.2;
+   const double b51 = -11.0 / 54.0;
+   const double b52 = 2.5;
+   const double b53 = -70.0 / 27.0;
+   const double b54 = 35.0 / 27.0;
+   const double b61 = 1631.0 / 55296.0;
+   const double b62 = 175.0 / 512.0;
+   const double b63 = 575.0 / 13824.0;
+   const double b64 = 44275.0 / 110592.0;
+   const double b65 = 253.0 / 4096.0;
+   const double c1 = 37.0 / 378.0;
+   const double c3 = 250.0 / 621.0;
+   const double c4 = 125.0 / 594.0;
+   const double c6 = 512.0 / 1771.0;
+   const double dc5 = -277.00 / 14336.0;
+   const double dc1 = c1 - 2825.0 / 27648.0;
+   const double dc3 = c3 - 18575.0 / 48384.0;
+   const double dc4 = c4 - 13525.0 / 55296.0;
+   const double dc6 = c6 - 0.25;
+
+   ArrayType& ytemp = ws.ytemp;
+
+   ytemp = b21 * h * dydx + y;
+   derivs(x + a2 * h, ytemp, ws.ak2);
+
+   ytemp = y + h * (b31 * dydx + b32 * ws.ak2);
+   derivs(x + a3 * h, ytemp, ws.ak3);
+
+   ytemp = y + h * (b41 * dydx + b42 * ws.ak2 + b43 * ws.ak3);
+   derivs(x + a4 * h, ytemp, ws.ak4);
+
+   ytemp = y + h * (b51 * dydx + b52 * ws.ak2 + b53 * ws.ak3 + b54 * ws.ak4);
+   derivs(x + a5 * h, ytemp, ws.ak5);
+
+   ytemp = y + h * (b61 * dydx + b62 * ws.ak2 + b63 * ws.ak3 + b64 * ws.ak4 + b65 * ws.ak5);
+   derivs(x + a6 * h, ytemp, ws.ak6);
+
+   yout = y + h * (c1 * dydx + c3 * ws.ak3 + c4 * ws.ak4 + c6 * ws.ak6);
+   yerr = h * (dc1 * dydx + dc3 * ws.ak3 + dc4 * ws.ak4 + dc5 * ws.ak5 + dc6 * ws.ak6);
+}
+
+/// organises the variable step-size for Runge-Kutta evolution, using
+/// the buffers from the workspace (see rungeKuttaStepInPlace())
+template <typename ArrayType, typename Derivs>
+double odeStepperInPlace(ArrayType& y, const ArrayType& dydx, double& x, double htry,
+                  double eps, const ArrayType& yscal, Derivs& derivs,
+                  int& max_step_dir, Workspace<ArrayType>& ws)
+{
+   const double SAFETY = 0.9;
+   const double PGROW = -0.2;
+   const double PSHRNK = -0.25;
+   const double ERRCON = 1.89e-4;
+   double errmax;
+   double h = htry;
+   ArrayType& yerr = ws.yerr;
+   ArrayType& ytemp = ws.yout;
+
+   for (;;) {
+      rungeKuttaStepInPlace(y, dydx, x, h, ytemp, yerr, derivs, ws);
+      errmax = (yerr / yscal).abs().maxCoeff(&max_step_dir);
+      errmax  /= eps;
+      if (!std::isfinite(errmax)) {
+#ifdef ENABLE_VERBOSE
+         ERROR("odeStepper: non-perturbative running at Q = "
+               << std::exp(x) << " GeV of parameter y(" << max_step_dir
+               << ") = " << y(max_step_dir) << ", dy(" << max_step_dir
+               << ")/dx = " << dydx(max_step_dir));
+#endif
+         throw NonPerturbativeRunningError(std::exp(x), max_step_dir, y(max_step_dir));
+      }
+      if (errmax <= 1.0) {
+         break;
+      }
+      const double htemp = SAFETY * h * std::pow(errmax, PSHRNK);
+      h = (h >= 0.0 ? std::max(htemp, 0.1 * h) : std::min(htemp, 0.1 * h));
+      if (x + h == x) {
+#ifdef ENABLE_VERBOSE
+         ERROR("At Q = " << std::exp(x) << " GeV "
+               "stepsize underflow in odeStepper in parameter y("
+               << max_step_dir << ") = " << y(max_step_dir) << ", dy("
+               << max_step_dir << ")/dx = " << dydx(max_step_dir));
+#endif
+         throw NonPerturbativeRunningError(std::exp(x), max_step_dir, y(max_step_dir));
+      }
+   }
+   x += h;
+   y = ytemp;
+
+   return errmax > ERRCON ? SAFETY * h * std::pow(errmax,PGROW) : 5.0 * h;
+}
+
+/// Step observer which ignores all integration steps
+struct No_observer {
+   template <typename ArrayType>
+   void operator()(double, const ArrayType&, const ArrayType&) const {}
+};
+
+/// Organises integration of 1st order system of ODEs without heap
+/// allocations.  derivs(x, y, dydx) must write the derivatives into
+/// dydx.  The workspace is resized to the size of ystart if necessary.
+/// observer(x, y, dydx) is called at the start point and after each
+/// accepted step, including the end point.
+template <typename ArrayType, typename Derivs, typename Observer = No_observer>
+void integrateOdesInPlace(ArrayType& ystart, double from, double to, double eps,
+                   double h1, double hmin, Derivs derivs,
+                   Workspace<ArrayType>& ws, int max_steps = 400,
+                   Observer observer = Observer())
+{
+   const int nvar = ystart.size();
+   const double TINY = 1.0e-16;
+   double x = from;
+   double h = sign(h1, to - from);
+   int max_step_dir = 0;
+
+   ws.resize(nvar);
+
+   ArrayType& y = ws.y;
+   ArrayType& dydx = ws.dydx;
+   ArrayType& yscal = ws.yscal;
+
+   y = ystart;
+
+   for (int nstp = 0; nstp < max_steps; ++nstp) {
+      derivs(x, y, dydx);
+      observer(x, y, dydx);
+      yscal = y.abs() + (dydx * h).abs() + TINY;
+      if ((x + h - to) * (x + h - from) > 0.0) {
+         h = to - x;
+      }
+
+      const double hnext = odeStepperInPlace(y, dydx, x, h, eps, yscal, derivs, max_step_dir, ws);
+
+      if ((x - to) * (to - from) >= 0.0) {
+         if (!std::is_same<Observer, No_observer>::value) {
+            derivs(x, y, dydx);
+            observer(x, y, dydx);
+         }
+         ystart = y;
+         return;
+      }
+
+      h = hnext;
+
+      if (std::fabs(hnext) <= hmin) {
+         break;
+      }
+   }
+
+#ifdef ENABLE_VERBOSE
+   ERROR("Bailed out of rk.cpp:too many steps in integrateOdes\n"
+         "********** Q = " << std::exp(x) << " *********");
+   ERROR("max step in direction of " << max_step_dir);
+   for (int i = 0; i < nvar; i++)
+      ERROR("y(" << i << ") = " << y(i) << " dydx(" << i <<
+            ") = " << dydx(i));
+#endif
+
+   throw NonPerturbativeRunningError(std::exp(x), max_step_dir, y(max_step_dir));
+}
+
 } // namespace runge_kutta
 
 } // namespace flexiblesusy
@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <string>
 #include <utility>
 #include <Eigen/Core>
@@ -30,6 +31,7 @@
 #include "logger.hpp"
 #include "error.hpp"
 #include "ewsb_solver.hpp"
+#include "gsl_multiroot_fdfsolver.hpp"
 #include "gsl_multiroot_fsolver.hpp"
 #include "gsl_utils.hpp"
 #include "gsl_vector.hpp"
@@ -59,25 +61,39 @@ namespace flexiblesusy {
  * const double start[2] = { 10, 10 };
  * const int status = root_finder.find_root(start);
  * @endcode
+ *
+ * The solver types GSLHybridSJ and GSLNewtonJ use the Jacobian of the
+ * function, which can be provided as a function of type Jacobian_t.
+ * The Jacobian does not need to be exact: it is only used to choose
+ * the steps, while convergence is always tested with the function
+ * itself.  If no Jacobian is given, it is calculated by forward
+ * finite differences of the function.
  */
 template <std::size_t dimension>
 class Root_finder : public EWSB_solver {
 public:
    using Vector_t = Eigen::Matrix<double,dimension,1>;
+   using Matrix_t = Eigen::Matrix<double,dimension,dimension>;
    using Function_t = std::function<Vector_t(const Vector_t&)>;
-   enum Solver_type { GSLHybrid, GSLHybridS, GSLBroyden, GSLNewton };
+   using Jacobian_t = std::function<Matrix_t(const Vector_t&)>;
+   enum Solver_type { GSLHybrid, GSLHybridS, GSLBroyden, GSLNewton,
+                      GSLHybridSJ, GSLNewtonJ };
 
    Root_finder() = default;
    Root_finder(const Function_t&, std::size_t, double, Solver_type solver_type_ = GSLHybrid);
+   Root_finder(const Function_t&, const Jacobian_t&, std::size_t, double, Solver_type solver_type_ = GSLHybridSJ);
    virtual ~Root_finder() = default;
    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
    void set_function(const Function_t& f) { function = f; }
+   void set_jacobian(const Jacobian_t& j) { jacobian = j; }
    void set_precision(double p) { precision = p; }
    void set_max_iterations(std::size_t n) { max_iterations = n; }
    void set_solver_type(Solver_type t) { solver_type = t; }
    int find_root(const Vector_t&);
 
+   static Matrix_t forward_difference_jacobian(const Function_t&, const Vector_t&, const Vector_t&);
+
    // EWSB_solver interface methods
    virtual std::string name() const override { return std::string("Root_finder<") + solver_type_name() + ">"; }
    virtual int solve(const Eigen::VectorXd&) override;
@@ -88,11 +104,18 @@ private:
    double precision{1.e-2};            ///< precision goal
    Vector_t root{Vector_t::Zero()};    ///< the root
    Function_t function{nullptr};       ///< function to minimize
+   Jacobian_t jacobian{nullptr};       ///< Jacobian of the function (optional)
    Solver_type solver_type{GSLHybrid}; ///< solver type
 
+   template <class Solver> int iterate(Solver&);
+   bool uses_jacobian() const { return solver_type == GSLHybridSJ || solver_type == GSLNewtonJ; }
    const char* solver_type_name() const;
    const gsl_multiroot_fsolver_type* solver_type_to_gsl_pointer() const;
+   const gsl_multiroot_fdfsolver_type* solver_type_to_gsl_fdf_pointer() const;
    static int gsl_function(const gsl_vector*, void*, gsl_vector*);
+   static int gsl_function_fdf_f(const gsl_vector*, void*, gsl_vector*);
+   static int gsl_function_fdf_df(const gsl_vector*, void*, gsl_matrix*);
+   static int gsl_function_fdf_fdf(const gsl_vector*, void*, gsl_vector*, gsl_matrix*);
 
    static bool is_finite(const Vector_t& v) {
       return std::any_of(v.data(), v.data() + v.size(),
@@ -122,6 +145,31 @@ Root_finder<dimension>::Root_finder(
 {
 }
 
+/**
+ * Constructor
+ *
+ * @param function_ pointer to the function to minimize
+ * @param jacobian_ Jacobian of the function
+ * @param max_iterations_ maximum number of iterations
+ * @param precision_ precision goal
+ * @param solver_type_ GSL multiroot solver type
+ */
+template <std::size_t dimension>
+Root_finder<dimension>::Root_finder(
+   const Function_t& function_,
+   const Jacobian_t& jacobian_,
+   std::size_t max_iterations_,
+   double precision_,
+   Solver_type solver_type_
+)
+   : max_iterations(max_iterations_)
+   , precision(precision_)
+   , function(function_)
+   , jacobian(jacobian_)
+   , solver_type(solver_type_)
+{
+}
+
 /**
  * Start the minimization
  *
@@ -135,12 +183,35 @@ int Root_finder<dimension>::find_root(const Vector_t& start)
    if (!function)
       throw SetupError("Root_finder: function not callable");
 
-   int status;
-   std::size_t iter = 0;
+   if (uses_jacobian()) {
+      gsl_multiroot_function_fdf f = {gsl_function_fdf_f, gsl_function_fdf_df,
+                                      gsl_function_fdf_fdf, dimension, this};
+      GSL_multiroot_fdfsolver solver(solver_type_to_gsl_fdf_pointer(), dimension, &f, to_GSL_vector(start));
+      return iterate(solver);
+   }
+
    void* parameters = &function;
    gsl_multiroot_function f = {gsl_function, dimension, parameters};
    GSL_multiroot_fsolver solver(solver_type_to_gsl_pointer(), dimension, &f, to_GSL_vector(start));
 
+   return iterate(solver);
+}
+
+/**
+ * Iterates the given GSL solver until the root is found, the solver
+ * is stuck or the maximum number of iterations is reached.
+ *
+ * @param solver GSL solver, initialized with the starting point
+ *
+ * @return GSL error code (GSL_SUCCESS if minimum found)
+ */
+template <std::size_t dimension>
+template <class Solver>
+int Root_finder<dimension>::iterate(Solver& solver)
+{
+   int status;
+   std::size_t iter = 0;
+
 #ifndef ENABLE_DEBUG
    gsl_set_error_handler_off();
 #endif
@@ -192,6 +263,88 @@ int Root_finder<dimension>::gsl_function(const gsl_vector* x, void* params, gsl_
    return status;
 }
 
+/**
+ * Calculates the Jacobian of a function by forward finite differences.
+ * This function calls the function once per dimension.
+ *
+ * @param fun function
+ * @param x point at which the Jacobian is to be calculated
+ * @param fx value of the function at x
+ *
+ * @return Jacobian, J(i,j) = d fun_i / d x_j
+ */
+template <std::size_t dimension>
+typename Root_finder<dimension>::Matrix_t Root_finder<dimension>::forward_difference_jacobian(
+   const Function_t& fun, const Vector_t& x, const Vector_t& fx)
+{
+   const double eps = std::sqrt(std::numeric_limits<double>::epsilon());
+   Matrix_t jac;
+
+   for (std::size_t j = 0; j < dimension; j++) {
+      Vector_t xph(x);
+      const double h = x(j) == 0. ? eps : eps * std::abs(x(j));
+      xph(j) += h;
+      jac.col(j) = (fun(xph) - fx) / (xph(j) - x(j));
+   }
+
+   return jac;
+}
+
+template <std::size_t dimension>
+int Root_finder<dimension>::gsl_function_fdf_f(const gsl_vector* x, void* params, gsl_vector* f)
+{
+   Root_finder* self = static_cast<Root_finder*>(params);
+   return gsl_function(x, &self->function, f);
+}
+
+template <std::size_t dimension>
+int Root_finder<dimension>::gsl_function_fdf_df(const gsl_vector* x, void* params, gsl_matrix* J)
+{
+   if (!flexiblesusy::is_finite(x)) {
+      gsl_matrix_set_all(J, std::numeric_limits<double>::max());
+      return GSL_EDOM;
+   }
+
+   Root_finder* self = static_cast<Root_finder*>(params);
+   int status = GSL_SUCCESS;
+   const Vector_t arg(to_eigen_vector<dimension>(x));
+   Matrix_t result;
+   result.setConstant(std::numeric_limits<double>::max());
+
+   try {
+      if (self->jacobian) {
+         result = self->jacobian(arg);
+      } else {
+         result = forward_difference_jacobian(self->function, arg, self->function(arg));
+      }
+      status = result.allFinite() ? GSL_SUCCESS : GSL_EDOM;
+   } catch (const flexiblesusy::Error&) {
+      status = GSL_EDOM;
+   }
+
+   // copy result -> J
+   for (std::size_t i = 0; i < dimension; i++) {
+      for (std::size_t j = 0; j < dimension; j++) {
+         gsl_matrix_set(J, i, j, result(i, j));
+      }
+   }
+
+   return status;
+}
+
+template <std::size_t dimension>
+int Root_finder<dimension>::gsl_function_fdf_fdf(const gsl_vector* x, void* params, gsl_vector* f, gsl_matrix* J)
+{
+   const int status = gsl_function_fdf_f(x, params, f);
+
+   if (status != GSL_SUCCESS) {
+      gsl_matrix_set_all(J, std::numeric_limits<double>::max());
+      return status;
+   }
+
+   return gsl_function_fdf_df(x, params, J);
+}
+
 template <std::size_t dimension>
 const char* Root_finder<dimension>::solver_type_name() const
 {
@@ -200,6 +353,8 @@ const char* Root_finder<dimension>::solver_type_name() const
    case GSLHybridS: return "GSLHybridS";
    case GSLBroyden: return "GSLBroyden";
    case GSLNewton : return "GSLNewton";
+   case GSLHybridSJ: return "GSLHybridSJ";
+   case GSLNewtonJ: return "GSLNewtonJ";
    default:
       throw SetupError("Unknown root solver type: "
                        + std::to_string(solver_type));
@@ -224,6 +379,20 @@ const gsl_multiroot_fsolver_type* Root_finder<dimension>::solver_type_to_gsl_poi
    return nullptr;
 }
 
+template <std::size_t dimension>
+const gsl_multiroot_fdfsolver_type* Root_finder<dimension>::solver_type_to_gsl_fdf_pointer() const
+{
+   switch (solver_type) {
+   case GSLHybridSJ: return gsl_multiroot_fdfsolver_hybridsj;
+   case GSLNewtonJ: return gsl_multiroot_fdfsolver_newton;
+   default:
+      throw SetupError("Unknown root solver type with Jacobian: "
+                       + std::to_string(solver_type));
+   }
+
+   return nullptr;
+}
+
 template <std::size_t dimension>
 int Root_finder<dimension>::solve(const Eigen::VectorXd& start)
 {
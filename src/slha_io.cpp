@@ -24,18 +24,21 @@
 #include "numerics2.hpp"
 #include "physical_input.hpp"
 #include "pmns.hpp"
+#include "profiling.hpp"
 #include "slhaea.h"
 #include "spectrum_generator_settings.hpp"
 #include "string_conversion.hpp"
 #include "string_format.hpp"
 
 #include <algorithm>
+#include <cctype>
 #include <cmath>
 #include <complex>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 namespace flexiblesusy {
 
@@ -46,6 +49,15 @@ int round(double a) noexcept
    return static_cast<int>(a >= 0. ? a + 0.5 : a - 0.5);
 }
 
+/// converts to upper case, as block names and keys are case-insensitive
+std::string to_upper(std::string str)
+{
+   for (auto& c: str) {
+      c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+   }
+   return str;
+}
+
 /**
  * fill Modsel struct from given key - value pair
  *
@@ -286,56 +298,34 @@ bool read_scale(const SLHAea::Line& line, double& scale)
 }
 
 template <typename T>
-double read_matrix_(const SLHAea::Coll& data, const std::string& block_name, T* a, int rows, int cols)
+void read_matrix_(const SLHAea::Block& block, T* a, int rows, int cols, double& scale)
 {
-   auto block = SLHAea::Coll::find(data.cbegin(), data.cend(), block_name);
-
-   double scale = 0.;
-
-   while (block != data.cend()) {
-      for (const auto& line: *block) {
-         detail::read_scale(line, scale);
-
-         if (line.is_data_line() && line.size() >= 3) {
-            const int i = to_int(line[0].c_str()) - 1;
-            const int k = to_int(line[1].c_str()) - 1;
-            if (0 <= i && i < rows && 0 <= k && k < cols) {
-               a[k*cols + i] = to_double(line[2].c_str());
-            }
+   for (const auto& line: block) {
+      detail::read_scale(line, scale);
+
+      if (line.is_data_line() && line.size() >= 3) {
+         const int i = to_int(line[0].c_str()) - 1;
+         const int k = to_int(line[1].c_str()) - 1;
+         if (0 <= i && i < rows && 0 <= k && k < cols) {
+            a[k*cols + i] = to_double(line[2].c_str());
          }
       }
-
-      ++block;
-      block = SLHAea::Coll::find(block, data.cend(), block_name);
    }
-
-   return scale;
 }
 
 template <typename T>
-double read_vector_(const SLHAea::Coll& data, const std::string& block_name, T* a, int len)
+void read_vector_(const SLHAea::Block& block, T* a, int len, double& scale)
 {
-   auto block = SLHAea::Coll::find(data.cbegin(), data.cend(), block_name);
+   for (const auto& line: block) {
+      detail::read_scale(line, scale);
 
-   double scale = 0.;
-
-   while (block != data.cend()) {
-      for (const auto& line: *block) {
-         detail::read_scale(line, scale);
-
-         if (line.is_data_line() && line.size() >= 2) {
-            const int i = to_int(line[0].c_str()) - 1;
-            if (0 <= i && i < len) {
-               a[i] = to_double(line[1].c_str());
-            }
+      if (line.is_data_line() && line.size() >= 2) {
+         const int i = to_int(line[0].c_str()) - 1;
+         if (0 <= i && i < len) {
+            a[i] = to_double(line[1].c_str());
          }
       }
-
-      ++block;
-      block = SLHAea::Coll::find(block, data.cend(), block_name);
    }
-
-   return scale;
 }
 
 
@@ -412,6 +402,31 @@ std::string format_matrix_imag(const std::string& name, const T* a, const std::s
 } // namespace detail
 
 
+/**
+ * @class SLHA_io::Index
+ * @brief Index of the blocks and entries of the SLHA data
+ *
+ * Maps the upper case block names to the blocks with this name (in
+ * the order of appearance) and to the last data line of each key.
+ * The pointers refer to the blocks stored in SLHA_io::data and
+ * become invalid when a block is erased.
+ */
+struct SLHA_io::Index {
+   struct Block_entries {
+      std::vector<const SLHAea::Block*> blocks;                     ///< blocks with the same name
+      std::unordered_map<std::string, const SLHAea::Line*> entries; ///< last data line of each key
+   };
+
+   std::unordered_map<std::string, Block_entries> blocks; ///< block name -> blocks and entries
+
+   const Block_entries* find(const std::string& block_name) const
+   {
+      const auto it = blocks.find(to_upper(block_name));
+      return it == blocks.cend() ? nullptr : &it->second;
+   }
+};
+
+
 SLHA_io::SLHA_io()
    : data(std::make_unique<SLHAea::Coll>())
 {
@@ -422,11 +437,15 @@ SLHA_io::SLHA_io(const SLHA_io& other)
    : data(std::make_unique<SLHAea::Coll>(*other.data))
    , modsel(other.modsel)
 {
+   if (other.index) {
+      build_index();
+   }
 }
 
 
 SLHA_io::SLHA_io(SLHA_io&& other) noexcept
    : data(std::move(other.data))
+   , index(std::move(other.index))
    , modsel(std::move(other.modsel))
 {
 }
@@ -444,6 +463,7 @@ SLHA_io& SLHA_io::operator=(const SLHA_io& other)
 SLHA_io& SLHA_io::operator=(SLHA_io&& other) noexcept
 {
    data = std::move(other.data);
+   index = std::move(other.index);
    modsel = std::move(other.modsel);
    return *this;
 }
@@ -452,6 +472,7 @@ SLHA_io& SLHA_io::operator=(SLHA_io&& other) noexcept
 void SLHA_io::clear()
 {
    data->clear();
+   index.reset();
    modsel.clear();
 }
 
@@ -465,6 +486,59 @@ const SLHAea::Coll& SLHA_io::get_data() const
 void SLHA_io::set_data(const SLHAea::Coll& data_)
 {
    data.reset(new SLHAea::Coll(data_));
+   build_index();
+}
+
+
+/**
+ * Indexes the blocks and their data lines, such that blocks and
+ * entries can be found without searching through all blocks.
+ */
+void SLHA_io::build_index()
+{
+   auto idx = std::make_unique<Index>();
+
+   for (const auto& block: *data) {
+      auto& entries = idx->blocks[to_upper(block.name())];
+      entries.blocks.push_back(&block);
+
+      for (const auto& line: block) {
+         if (line.is_data_line() && line.size() > 1) {
+            entries.entries[to_upper(line[0])] = &line;
+         }
+      }
+   }
+
+   index = std::move(idx);
+}
+
+
+/**
+ * Calls a function for each block with the given name, in the order
+ * of appearance.  The index is used if available.
+ *
+ * @param block_name block name
+ * @param f function to be called with each block
+ */
+template <class F>
+void SLHA_io::for_each_block(const std::string& block_name, F&& f) const
+{
+   if (index) {
+      if (const auto* entries = index->find(block_name)) {
+         for (const auto* block: entries->blocks) {
+            f(*block);
+         }
+      }
+      return;
+   }
+
+   auto block = SLHAea::Coll::find(data->cbegin(), data->cend(), block_name);
+
+   while (block != data->cend()) {
+      f(*block);
+      ++block;
+      block = SLHAea::Coll::find(block, data->cend(), block_name);
+   }
 }
 
 
@@ -485,6 +559,9 @@ std::string SLHA_io::block_head(const std::string& name, double scale)
 
 bool SLHA_io::block_exists(const std::string& block_name) const
 {
+   if (index) {
+      return index->find(block_name) != nullptr;
+   }
    return data->find(block_name) != data->cend();
 }
 
@@ -527,6 +604,7 @@ void SLHA_io::read_from_stream(std::istream& istr)
 {
    data->clear();
    data->read(istr);
+   build_index();
    read_modsel();
 }
 
@@ -634,11 +712,10 @@ void SLHA_io::fill(Spectrum_generator_settings& settings) const
  */
 double SLHA_io::read_block(const std::string& block_name, const Tuple_processor& processor) const
 {
-   auto block = SLHAea::Coll::find(data->cbegin(), data->cend(), block_name);
    double scale = 0.;
 
-   while (block != data->cend()) {
-      for (const auto& line: *block) {
+   for_each_block(block_name, [&] (const SLHAea::Block& block) {
+      for (const auto& line: block) {
          read_scale(line, scale);
 
          if (line.is_data_line() && line.size() >= 2) {
@@ -647,10 +724,7 @@ double SLHA_io::read_block(const std::string& block_name, const Tuple_processor&
             processor(key, value);
          }
       }
-
-      ++block;
-      block = SLHAea::Coll::find(block, data->cend(), block_name);
-   }
+   });
 
    return scale;
 }
@@ -665,27 +739,43 @@ double SLHA_io::read_block(const std::string& block_name, const Tuple_processor&
  */
 double SLHA_io::read_block(const std::string& block_name, double& entry) const
 {
-   auto block = SLHAea::Coll::find(data->cbegin(), data->cend(), block_name);
    double scale = 0.;
 
-   while (block != data->cend()) {
-      for (const auto& line: *block) {
+   for_each_block(block_name, [&] (const SLHAea::Block& block) {
+      for (const auto& line: block) {
          read_scale(line, scale);
 
          if (line.is_data_line()) {
             entry = to_double(line[0].c_str());
          }
       }
-
-      ++block;
-      block = SLHAea::Coll::find(block, data->cend(), block_name);
-   }
+   });
 
    return scale;
 }
 
+/**
+ * Reads an entry from a SLHA block.  If the key appears several
+ * times, the last value is returned.
+ *
+ * @param block_name block name
+ * @param key key of the entry
+ *
+ * @return value of the entry (or 0 if the entry does not exist)
+ */
 double SLHA_io::read_entry(const std::string& block_name, int key) const
 {
+   if (index) {
+      const auto* entries = index->find(block_name);
+      if (entries) {
+         const auto line = entries->entries.find(flexiblesusy::to_string(key));
+         if (line != entries->entries.cend()) {
+            return to_double(line->second->at(1).c_str());
+         }
+      }
+      return 0.;
+   }
+
    auto block = SLHAea::Coll::find(data->cbegin(), data->cend(), block_name);
    double entry = 0.;
    const SLHAea::Block::key_type keys(1, flexiblesusy::to_string(key));
@@ -719,16 +809,12 @@ double SLHA_io::read_entry(const std::string& block_name, int key) const
 double SLHA_io::read_scale(const std::string& block_name) const
 {
    double scale = 0.;
-   auto block = SLHAea::Coll::find(data->cbegin(), data->cend(), block_name);
 
-   while (block != data->cend()) {
-      for (const auto& line: *block) {
+   for_each_block(block_name, [&scale] (const SLHAea::Block& block) {
+      for (const auto& line: block) {
          read_scale(line, scale);
       }
-
-      ++block;
-      block = SLHAea::Coll::find(block, data->cend(), block_name);
-   }
+   });
 
    return scale;
 }
@@ -743,6 +829,8 @@ void SLHA_io::set_block(const std::string& lines, Position position)
    SLHAea::Block block;
    block.str(lines);
 
+   // erasing a block invalidates the index
+   index.reset();
    data->erase(block.name());
 
    if (position == front) {
@@ -850,6 +938,8 @@ void SLHA_io::write_to_file(const std::string& file_name) const
 
 void SLHA_io::write_to_stream(std::ostream& ostr) const
 {
+   PROFILE_SCOPE("SLHA output (write)");
+
    if (ostr.good()) {
       ostr << *data;
    } else {
@@ -866,25 +956,41 @@ void SLHA_io::write_to_stream() const
 
 double SLHA_io::read_vector(const std::string& block_name, double* a, int len) const
 {
-   return detail::read_vector_(*data, block_name, a, len);
+   double scale = 0.;
+   for_each_block(block_name, [&] (const SLHAea::Block& block) {
+      detail::read_vector_(block, a, len, scale);
+   });
+   return scale;
 }
 
 
 double SLHA_io::read_vector(const std::string& block_name, std::complex<double>* a, int len) const
 {
-   return detail::read_vector_(*data, block_name, a, len);
+   double scale = 0.;
+   for_each_block(block_name, [&] (const SLHAea::Block& block) {
+      detail::read_vector_(block, a, len, scale);
+   });
+   return scale;
 }
 
 
 double SLHA_io::read_matrix(const std::string& block_name, double* a, int rows, int cols) const
 {
-   return detail::read_matrix_(*data, block_name, a, rows, cols);
+   double scale = 0.;
+   for_each_block(block_name, [&] (const SLHAea::Block& block) {
+      detail::read_matrix_(block, a, rows, cols, scale);
+   });
+   return scale;
 }
 
 
 double SLHA_io::read_matrix(const std::string& block_name, std::complex<double>* a, int rows, int cols) const
 {
-   return detail::read_matrix_(*data, block_name, a, rows, cols);
+   double scale = 0.;
+   for_each_block(block_name, [&] (const SLHAea::Block& block) {
+      detail::read_matrix_(block, a, rows, cols, scale);
+   });
+   return scale;
 }
 
 
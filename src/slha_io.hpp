@@ -51,11 +51,14 @@ namespace flexiblesusy {
  *
  * Reading: There are two ways to read block entries from SLHA files:
  * a) using the read_block() function with a %SLHA_io::Tuple_processor
- * or b) using the read_entry() function for each entry.  Note, that
- * a) is much faster than b) (more than 1000 times) because b) needs
- * to search for the block each time read_entry() is called.
+ * or b) using the read_entry() function for each entry.  After the
+ * data have been read via read_from_file(), read_from_source(),
+ * read_from_stream() or set_data(), the blocks and their entries are
+ * indexed, such that both a) and b) find a block or an entry in
+ * constant time.  The index is dropped when a block is modified via
+ * set_block(), after which the blocks are searched linearly again.
  *
- * Example how to use a tuple processor (fast!):
+ * Example how to use a tuple processor:
  * \code{.cpp}
 void process_tuple(double* array, int key, double value) {
    array[key] = value;
@@ -75,7 +78,7 @@ void read_file() {
 }
  * \endcode
  *
- * Example how to use a for loop (slow!):
+ * Example how to use a for loop:
  * \code{.cpp}
 void read_file() {
    double array[1000];
@@ -151,12 +154,18 @@ public:
    void write_to_stream(std::ostream&) const;
 
 private:
+   struct Index;
+
    std::unique_ptr<SLHAea::Coll> data; ///< SHLA data
+   std::unique_ptr<Index> index;       ///< block and entry index of data
    Modsel modsel{};            ///< data from block MODSEL
 
    static std::string block_head(const std::string& name, double scale);
    static bool read_scale(const SLHAea::Line& line, double& scale);
 
+   void build_index();
+   template <class F>
+   void for_each_block(const std::string&, F&&) const;
    void read_modsel();
    double read_matrix(const std::string&, double*, int, int) const;
    double read_matrix(const std::string&, std::complex<double>*, int, int) const;
@@ -20,27 +20,170 @@
 #define THREAD_POOL_H
 
 #include "logger.hpp"
+#include "profiling.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
-#include <functional>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
 #include <stdexcept>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace flexiblesusy {
 
+/**
+ * @class Small_task
+ * @brief Move-only type-erased callable of signature void()
+ *
+ * Callables which fit into the internal buffer of buffer_size bytes
+ * (and are nothrow move constructible) are stored in-place without
+ * heap allocation.  Larger callables are stored on the heap.
+ */
+class Small_task {
+public:
+   static constexpr std::size_t buffer_size = 64;
+
+   Small_task() noexcept = default;
+
+   template <typename F, typename = typename std::enable_if<
+                            !std::is_same<typename std::decay<F>::type, Small_task>::value>::type>
+   Small_task(F&& f)
+   {
+      using Fn = typename std::decay<F>::type;
+      emplace<Fn>(std::forward<F>(f), Is_small<Fn>{});
+   }
+
+   Small_task(const Small_task&) = delete;
+   Small_task& operator=(const Small_task&) = delete;
+
+   Small_task(Small_task&& other) noexcept { move_from(other); }
+
+   Small_task& operator=(Small_task&& other) noexcept
+   {
+      if (this != &other) {
+         reset();
+         move_from(other);
+      }
+      return *this;
+   }
+
+   ~Small_task() { reset(); }
+
+   void operator()() { ops->invoke(&storage); }
+   explicit operator bool() const noexcept { return ops != nullptr; }
+
+private:
+   using Storage = typename std::aligned_storage<buffer_size, alignof(std::max_align_t)>::type;
+
+   struct Operations {
+      void (*invoke)(void*);
+      void (*relocate)(void* dst, void* src) noexcept; ///< move src to dst and destroy src
+      void (*destroy)(void*) noexcept;
+   };
+
+   template <typename Fn>
+   using Is_small = std::integral_constant<
+      bool, sizeof(Fn) <= buffer_size && alignof(Fn) <= alignof(Storage) &&
+               std::is_nothrow_move_constructible<Fn>::value>;
+
+   /// operations for callables stored in the buffer
+   template <typename Fn>
+   struct Local_ops {
+      static void invoke(void* p) { (*static_cast<Fn*>(p))(); }
+      static void relocate(void* dst, void* src) noexcept {
+         ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+         static_cast<Fn*>(src)->~Fn();
+      }
+      static void destroy(void* p) noexcept { static_cast<Fn*>(p)->~Fn(); }
+      static const Operations* get() {
+         static const Operations ops{&invoke, &relocate, &destroy};
+         return &ops;
+      }
+   };
+
+   /// operations for callables stored on the heap
+   template <typename Fn>
+   struct Heap_ops {
+      static Fn*& ptr(void* p) { return *static_cast<Fn**>(p); }
+      static void invoke(void* p) { (*ptr(p))(); }
+      static void relocate(void* dst, void* src) noexcept {
+         ::new (dst) Fn*(ptr(src));
+      }
+      static void destroy(void* p) noexcept { delete ptr(p); }
+      static const Operations* get() {
+         static const Operations ops{&invoke, &relocate, &destroy};
+         return &ops;
+      }
+   };
+
+   Storage storage;
+   const Operations* ops{nullptr};
+
+   template <typename Fn, typename F>
+   void emplace(F&& f, std::true_type)
+   {
+      ::new (&storage) Fn(std::forward<F>(f));
+      ops = Local_ops<Fn>::get();
+   }
+
+   template <typename Fn, typename F>
+   void emplace(F&& f, std::false_type)
+   {
+      ::new (&storage) Fn*(new Fn(std::forward<F>(f)));
+      ops = Heap_ops<Fn>::get();
+   }
+
+   void move_from(Small_task& other) noexcept
+   {
+      if (other.ops) {
+         other.ops->relocate(&storage, &other.storage);
+         ops = other.ops;
+         other.ops = nullptr;
+      }
+   }
+
+   void reset() noexcept
+   {
+      if (ops) {
+         ops->destroy(&storage);
+         ops = nullptr;
+      }
+   }
+};
+
 /**
  * @class Thread_pool
  * @brief A pool of threads
  *
  * Thread_pool represents a collection of threads.  Tasks (callables)
- * can be added to an internal queue.  The tasks will be executed as
- * soon as there is an idle thread.  The destructor of the Thread_pool
- * will wait until all tasks are finished and the queue is empty.
+ * can be added to the pool.  The tasks will be executed as soon as
+ * there is an idle thread.  The destructor of the Thread_pool will
+ * wait until all tasks are finished.
+ *
+ * Each thread owns a task deque.  Tasks submitted from a pool thread
+ * are pushed to the thread's own deque, tasks submitted from outside
+ * are distributed round-robin over the deques.  A thread takes tasks
+ * from the front of its own deque and, when it runs empty, steals
+ * tasks from the back of the other deques.  The deques are guarded
+ * by per-thread locks, which are only contended when stealing.  Idle
+ * threads sleep on a condition variable, which is only touched when
+ * there are sleeping threads.
+ *
+ * Tasks are stored in a Small_task, so small callables do not
+ * require a heap allocation.
+ *
+ * If profiling is enabled, the pool threads merge their profile into
+ * the process-wide profile after each task, see
+ * profiling::merge_thread_profile().
  *
  * @param pool_size number of threads in the pool
  */
@@ -50,23 +193,9 @@ public:
    {
       VERBOSE_MSG("launching " << pool_size << " threads ...");
       for (std::size_t i = 0; i < pool_size; ++i)
-         threads.emplace_back(
-            [this] () {
-               for (;;) {
-                  std::function<void()> task;
-
-                  {
-                     std::unique_lock<std::mutex> lock(mutex);
-                     condition.wait(lock, [this]{ return stop || !tasks.empty(); });
-                     if (stop && tasks.empty())
-                        return;
-                     task = std::move(tasks.front());
-                     tasks.pop();
-                  }
-
-                  task();
-               }
-            });
+         queues.emplace_back(std::make_unique<Task_queue>());
+      for (std::size_t i = 0; i < pool_size; ++i)
+         threads.emplace_back([this, i] () { work(i); });
    }
 
    Thread_pool(const Thread_pool&) = delete;
@@ -98,18 +227,13 @@ public:
    {
       using return_t = decltype(task());
 
-      auto ptask = std::make_shared<std::packaged_task<return_t()>>([task](){ return task(); });
-
-      std::future<return_t> fut = ptask->get_future();
+      std::packaged_task<return_t()> ptask(std::forward<Task>(task));
+      std::future<return_t> fut = ptask.get_future();
 
       if (threads.empty()) {
-         (*ptask)();
+         ptask();
       } else {
-         {
-            std::unique_lock<std::mutex> lock(mutex);
-            tasks.emplace([ptask](){ (*ptask)(); });
-         }
-         condition.notify_one();
+         push(Small_task(std::move(ptask)));
       }
 
       return fut;
@@ -122,22 +246,237 @@ public:
       if (threads.empty()) {
          task();
       } else {
-         {
+         push(Small_task(std::forward<Task>(task)));
+      }
+   }
+
+   /**
+    * Calls f(i) for all i in [begin, end) and waits until all calls
+    * have finished.  The index range is split into chunks, which are
+    * processed by the pool threads and by the calling thread.  If
+    * f throws, the first exception is re-thrown.
+    *
+    * This function may be called from within a task.
+    *
+    * @param begin first index
+    * @param end last index (excluded)
+    * @param f function to be called for each index
+    * @param chunk_size number of indices per chunk (0 = automatic)
+    */
+   template <typename F>
+   void parallel_for(std::size_t begin, std::size_t end, F&& f, std::size_t chunk_size = 0)
+   {
+      if (begin >= end)
+         return;
+
+      const std::size_t n = end - begin;
+
+      if (chunk_size == 0)
+         chunk_size = std::max<std::size_t>(1, n / (4*(threads.size() + 1)));
+
+      const std::size_t n_chunks = (n + chunk_size - 1) / chunk_size;
+
+      if (threads.empty() || n_chunks == 1) {
+         for (std::size_t i = begin; i < end; ++i)
+            f(i);
+         return;
+      }
+
+      std::atomic<std::size_t> next_chunk{0};
+      std::atomic<std::size_t> finished_helpers{0};
+      std::exception_ptr first_exception{};
+      std::mutex exception_mutex;
+
+      const auto process_chunks = [&] () {
+         for (;;) {
+            const std::size_t c = next_chunk.fetch_add(1);
+            if (c >= n_chunks)
+               break;
+            const std::size_t lo = begin + c*chunk_size;
+            const std::size_t hi = std::min(end, lo + chunk_size);
+            try {
+               for (std::size_t i = lo; i < hi; ++i)
+                  f(i);
+            } catch (...) {
+               std::lock_guard<std::mutex> lock(exception_mutex);
+               if (!first_exception)
+                  first_exception = std::current_exception();
+            }
+         }
+      };
+
+      const std::size_t n_helpers = std::min(threads.size(), n_chunks - 1);
+
+      for (std::size_t h = 0; h < n_helpers; ++h) {
+         push(Small_task([this, &process_chunks, &finished_helpers] () {
+            process_chunks();
+            // make the profile complete before the caller continues
+            if (this_worker().pool == this)
+               PROFILE_MERGE_THREAD();
+            finished_helpers.fetch_add(1);
+         }));
+      }
+
+      process_chunks();
+
+      // the helpers refer to local variables, so wait for all of them
+      while (finished_helpers.load() < n_helpers) {
+         if (!run_pending_task())
+            std::this_thread::yield();
+      }
+
+      if (first_exception)
+         std::rethrow_exception(first_exception);
+   }
+
+   /**
+    * Waits until all tasks submitted so far have finished.  The
+    * calling thread helps processing pending tasks.
+    *
+    * @attention Must not be called from within a task of this pool.
+    */
+   void wait_all()
+   {
+      while (unfinished.load() > 0) {
+         if (!run_pending_task()) {
             std::unique_lock<std::mutex> lock(mutex);
-            tasks.emplace(std::forward<Task>(task));
+            finished.wait(lock, [this] { return unfinished.load() == 0 || queued.load() > 0; });
          }
-         condition.notify_one();
       }
    }
 
    std::size_t size() const { return threads.size(); }
 
 private:
+   /// task deque owned by one thread
+   struct Task_queue {
+      std::deque<Small_task> tasks{};
+      std::mutex mutex{};
+   };
+
+   /// pool and queue index of the current thread
+   struct Worker_id {
+      const Thread_pool* pool{nullptr};
+      std::size_t index{0};
+   };
+
+   std::vector<std::unique_ptr<Task_queue>> queues{};
    std::vector<std::thread> threads{};
-   std::queue<std::function<void()>> tasks{};
+   std::atomic<std::size_t> queued{0};     ///< number of tasks in the deques
+   std::atomic<std::size_t> unfinished{0}; ///< number of submitted, unfinished tasks
+   std::atomic<std::size_t> sleeping{0};   ///< number of sleeping threads
+   std::atomic<std::size_t> next_queue{0}; ///< queue for next external task
    std::mutex mutex{};
-   std::condition_variable condition{};
+   std::condition_variable condition{};    ///< wakes up sleeping threads
+   std::condition_variable finished{};     ///< signals unfinished == 0
    bool stop{false};
+
+   static Worker_id& this_worker()
+   {
+      static thread_local Worker_id id;
+      return id;
+   }
+
+   void push(Small_task&& task)
+   {
+      const Worker_id& id = this_worker();
+      const std::size_t q = id.pool == this
+         ? id.index : next_queue.fetch_add(1) % queues.size();
+
+      unfinished.fetch_add(1);
+
+      {
+         std::lock_guard<std::mutex> lock(queues[q]->mutex);
+         queues[q]->tasks.push_back(std::move(task));
+      }
+
+      queued.fetch_add(1);
+
+      if (sleeping.load() > 0) {
+         { std::lock_guard<std::mutex> lock(mutex); }
+         condition.notify_one();
+      }
+   }
+
+   /// takes a task from the front of queue q
+   bool pop(std::size_t q, Small_task& task)
+   {
+      std::lock_guard<std::mutex> lock(queues[q]->mutex);
+      auto& tasks = queues[q]->tasks;
+      if (tasks.empty())
+         return false;
+      task = std::move(tasks.front());
+      tasks.pop_front();
+      queued.fetch_sub(1);
+      return true;
+   }
+
+   /// takes a task from the back of a queue other than q
+   bool steal(std::size_t q, Small_task& task)
+   {
+      const std::size_t n = queues.size();
+      for (std::size_t k = 1; k < n; ++k) {
+         auto& victim = *queues[(q + k) % n];
+         std::lock_guard<std::mutex> lock(victim.mutex);
+         if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+         }
+      }
+      return false;
+   }
+
+   void execute(Small_task& task)
+   {
+      task();
+      task = Small_task();
+
+      if (unfinished.fetch_sub(1) == 1) {
+         { std::lock_guard<std::mutex> lock(mutex); }
+         finished.notify_all();
+      }
+   }
+
+   /// runs one pending task in the calling thread, if there is one
+   bool run_pending_task()
+   {
+      if (queues.empty())
+         return false;
+
+      const Worker_id& id = this_worker();
+      const std::size_t q = id.pool == this ? id.index : 0;
+      Small_task task;
+
+      if (pop(q, task) || steal(q, task)) {
+         execute(task);
+         return true;
+      }
+
+      return false;
+   }
+
+   void work(std::size_t i)
+   {
+      this_worker() = Worker_id{this, i};
+      Small_task task;
+
+      for (;;) {
+         if (pop(i, task) || steal(i, task)) {
+            execute(task);
+            PROFILE_MERGE_THREAD();
+            continue;
+         }
+
+         std::unique_lock<std::mutex> lock(mutex);
+         sleeping.fetch_add(1);
+         condition.wait(lock, [this] { return stop || queued.load() > 0; });
+         sleeping.fetch_sub(1);
+         if (stop && queued.load() == 0)
+            return;
+      }
+   }
 };
 
 } // namespace flexiblesusy
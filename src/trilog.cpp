@@ -267,4 +267,20 @@ std::complex<long double> trilog(const std::complex<long double>& z_) noexcept
    return rest + u*horner(u, bf);
 }
 
+/**
+ * @brief Complex trilogarithm \f$\mathrm{Li}_3(z)\f$ of n arguments
+ * @param z array of n complex arguments
+ * @param result array of n results
+ * @param n number of arguments
+ *
+ * Convenience wrapper, which calls the scalar version for each
+ * argument.
+ */
+void trilog(const std::complex<double>* z, std::complex<double>* result, std::size_t n) noexcept
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      result[i] = trilog(z[i]);
+   }
+}
+
 } // namespace flexiblesusy
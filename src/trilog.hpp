@@ -20,6 +20,7 @@
 #define TRILOG_H
 
 #include <complex>
+#include <cstddef>
 
 namespace flexiblesusy {
 
@@ -29,6 +30,9 @@ std::complex<double> trilog(const std::complex<double>&) noexcept;
 /// complex trilogarithm (long double precision)
 std::complex<long double> trilog(const std::complex<long double>&) noexcept;
 
+/// complex trilogarithm of n arguments
+void trilog(const std::complex<double>*, std::complex<double>*, std::size_t) noexcept;
+
 } // namespace flexiblesusy
 
 #endif
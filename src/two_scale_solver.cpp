@@ -23,6 +23,7 @@
 #include "initial_guesser.hpp"
 #include "logger.hpp"
 #include "model.hpp"
+#include "profiling.hpp"
 #include "single_scale_constraint.hpp"
 #include "single_scale_matching.hpp"
 #include "two_scale_running_precision.hpp"
@@ -97,6 +98,8 @@ void RGFlow<Two_scale>::solve()
       ++iteration;
    }
 
+   PROFILE_COUNT("RGFlow<Two_scale> iterations", iteration);
+
    if (!accuracy_reached)
       throw NoConvergenceError(max_iterations);
 
@@ -134,6 +137,8 @@ void RGFlow<Two_scale>::initial_guess()
 
 void RGFlow<Two_scale>::run_sliders()
 {
+   PROFILE_SCOPE("RGFlow<Two_scale>::run_sliders");
+
    VERBOSE_MSG("> running all models (iteration " << iteration << ") ...");
 
    for (auto& s: sliders) {
@@ -0,0 +1,128 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "warm_start_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace flexiblesusy {
+
+/**
+ * Stores the state of a parameter point.  If the cache is full, the
+ * oldest state is removed.
+ *
+ * @param key key which identifies the parameter point
+ * @param state converged state of the parameter point
+ */
+void Warm_start_cache::add(const Eigen::ArrayXd& key, const Warm_start_state& state)
+{
+   if (capacity == 0) {
+      return;
+   }
+
+   while (entries.size() >= capacity) {
+      entries.pop_front();
+   }
+
+   entries.push_back(Entry{key, state});
+}
+
+/**
+ * Returns the state of the stored parameter point whose key is
+ * nearest to the given key.  Keys of different size are never
+ * considered to be near.
+ *
+ * @param key key which identifies the parameter point
+ *
+ * @return pointer to state or nullptr if no stored point is within
+ * the maximum distance
+ */
+const Warm_start_state* Warm_start_cache::find_nearest(const Eigen::ArrayXd& key) const
+{
+   const Warm_start_state* nearest = nullptr;
+   double min_distance = std::numeric_limits<double>::infinity();
+
+   // search from the most recent entry, which is likely the nearest
+   // one in a scan over a grid
+   for (auto it = entries.crbegin(); it != entries.crend(); ++it) {
+      if (it->key.size() != key.size()) {
+         continue;
+      }
+      const double d = distance(it->key, key, abs_scale);
+      if (d < min_distance) {
+         min_distance = d;
+         nearest = &it->state;
+         if (d == 0.) {
+            break;
+         }
+      }
+   }
+
+   return min_distance <= max_distance ? nearest : nullptr;
+}
+
+/**
+ * Sets the maximum number of stored states.  If more states are
+ * stored, the oldest ones are removed.
+ *
+ * @param capacity_ maximum number of stored states
+ */
+void Warm_start_cache::set_capacity(std::size_t capacity_)
+{
+   capacity = capacity_;
+
+   while (entries.size() > capacity) {
+      entries.pop_front();
+   }
+}
+
+/**
+ * Returns the largest relative difference of the entries of the two
+ * keys.  The difference of each entry is divided by the larger of
+ * the magnitudes of the two entries and the absolute scale.  Entries
+ * which are equal do not contribute.
+ *
+ * @param a key
+ * @param b key
+ * @param abs_scale lower bound of the denominator
+ *
+ * @return distance
+ */
+double Warm_start_cache::distance(const Eigen::ArrayXd& a, const Eigen::ArrayXd& b,
+                                  double abs_scale)
+{
+   double d = 0.;
+
+   for (Eigen::Index i = 0; i < a.size(); i++) {
+      const double diff = std::abs(a(i) - b(i));
+      if (diff == 0.) {
+         continue;
+      }
+      if (!std::isfinite(diff)) {
+         return std::numeric_limits<double>::infinity();
+      }
+      const double scale = std::max({std::abs(a(i)), std::abs(b(i)), abs_scale});
+      d = std::max(d, diff / scale);
+   }
+
+   return d;
+}
+
+} // namespace flexiblesusy
@@ -0,0 +1,110 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef WARM_START_CACHE_H
+#define WARM_START_CACHE_H
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace flexiblesusy {
+
+/**
+ * @class Warm_start_state
+ * @brief converged state of a boundary value problem
+ *
+ * The state contains the model parameters (including the parameters
+ * fixed by the EWSB conditions) at the given renormalization scale,
+ * together with the scales of the constraints.  It can be used to
+ * start the iteration of a neighbouring parameter point instead of
+ * the initial guess.
+ */
+struct Warm_start_state {
+   Eigen::ArrayXd parameters{};             ///< model parameters
+   double scale{0.};                        ///< renormalization scale of the parameters
+   std::vector<double> constraint_scales{}; ///< scales of the constraints
+};
+
+/**
+ * @class Warm_start_cache
+ * @brief stores converged states of past parameter points
+ *
+ * The states are stored together with a key, which identifies the
+ * parameter point (for example the input parameters together with
+ * the Standard Model input parameters).  find_nearest() returns the
+ * state of the stored point whose key is nearest to the given key,
+ * provided that the distance is not larger than the maximum
+ * distance.  The distance between two keys \f$a\f$ and \f$b\f$ is
+ *
+ * \f[ d(a,b) = \max_i \frac{|a_i - b_i|}{\max(|a_i|,|b_i|,s)} , \f]
+ *
+ * i.e. the largest relative difference of the key entries.  Entries
+ * whose magnitude is below the absolute scale \f$s\f$ are compared
+ * by their absolute difference in units of \f$s\f$, such that
+ * entries close to zero (for example trilinear couplings) do not
+ * prevent a warm start.  If the cache is full, the oldest state is
+ * removed.
+ *
+ * The cache is not thread-safe.  In a parallel scan each worker
+ * should own its own cache.
+ */
+class Warm_start_cache {
+public:
+   explicit Warm_start_cache(std::size_t capacity_ = 1000, double max_distance_ = 0.1,
+                             double abs_scale_ = 1.)
+      : capacity(capacity_), max_distance(max_distance_), abs_scale(abs_scale_) {}
+
+   /// store state of a parameter point with the given key
+   void add(const Eigen::ArrayXd&, const Warm_start_state&);
+   /// delete all stored states
+   void clear() { entries.clear(); }
+   /// returns true if no state is stored
+   bool empty() const { return entries.empty(); }
+   /// returns state of the nearest stored point (nullptr if none is near enough)
+   const Warm_start_state* find_nearest(const Eigen::ArrayXd&) const;
+   /// returns number of stored states
+   std::size_t size() const { return entries.size(); }
+
+   std::size_t get_capacity() const { return capacity; }
+   double get_max_distance() const { return max_distance; }
+   double get_abs_scale() const { return abs_scale; }
+   void set_capacity(std::size_t);
+   void set_max_distance(double d) { max_distance = d; }
+   void set_abs_scale(double s) { abs_scale = s; }
+
+   /// returns distance between two keys
+   static double distance(const Eigen::ArrayXd&, const Eigen::ArrayXd&, double abs_scale = 0.);
+
+private:
+   struct Entry {
+      Eigen::ArrayXd key{};
+      Warm_start_state state{};
+   };
+
+   std::size_t capacity{1000};  ///< maximum number of stored states
+   double max_distance{0.1};    ///< maximum distance of a usable state
+   double abs_scale{1.};        ///< lower bound of the denominator of the distance
+   std::deque<Entry> entries{}; ///< stored states (oldest first)
+};
+
+} // namespace flexiblesusy
+
+#endif
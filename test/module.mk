@@ -48,8 +48,11 @@ endif
 
 TEST_SRC := \
 		$(DIR)/test_array_view.cpp \
+		$(DIR)/test_betafunction_workspace.cpp \
 		$(DIR)/test_cast_model.cpp \
 		$(DIR)/test_ckm.cpp \
+		$(DIR)/test_columnar_file.cpp \
+		$(DIR)/test_coupling_table.cpp \
 		$(DIR)/test_logger.cpp \
 		$(DIR)/test_derivative.cpp \
 		$(DIR)/test_effective_couplings.cpp \
@@ -68,10 +71,14 @@ TEST_SRC := \
 		$(DIR)/test_MSSM_2L_limits.cpp \
 		$(DIR)/test_multiindex.cpp \
 		$(DIR)/test_numerics.cpp \
+		$(DIR)/test_numerics_batch.cpp \
 		$(DIR)/test_observable_problems.cpp \
 		$(DIR)/test_pmns.cpp \
+		$(DIR)/test_polylog_batch.cpp \
 		$(DIR)/test_problems.cpp \
+		$(DIR)/test_profiling.cpp \
 		$(DIR)/test_raii.cpp \
+		$(DIR)/test_rg_trajectory.cpp \
 		$(DIR)/test_root_finder.cpp \
 		$(DIR)/test_scan.cpp \
 		$(DIR)/test_sm_fourloop_as.cpp \
@@ -84,9 +91,12 @@ TEST_SRC := \
 		$(DIR)/test_threshold_corrections.cpp \
 		$(DIR)/test_threshold_loop_functions.cpp \
 		$(DIR)/test_spectrum_generator_settings.cpp \
+		$(DIR)/test_warm_start_cache.cpp \
 		$(DIR)/test_which.cpp \
 		$(DIR)/test_wrappers.cpp \
 		$(DIR)/test_looplibrary_softsusy.cpp \
+		$(DIR)/test_looplibrary_cache.cpp \
+		$(DIR)/test_looplibrary_context.cpp \
 		$(DIR)/test_looplibrary_environment.cpp
 
 TEST_SH := \
@@ -143,6 +153,7 @@ endif
 
 ifeq ($(ENABLE_THREADS),yes)
 TEST_SRC += \
+		$(DIR)/test_parallel_scan.cpp \
 		$(DIR)/test_thread_pool.cpp
 endif
 
@@ -251,6 +262,11 @@ TEST_SRC += \
 		$(DIR)/test_SMSSM_tree_level_spectrum.cpp
 endif
 
+ifeq ($(ENABLE_SQLITE),yes)
+TEST_SRC += \
+		$(DIR)/test_database.cpp
+endif
+
 ifeq ($(ENABLE_SQLITE) $(WITH_CMSSM),yes yes)
 TEST_SRC += \
 		$(DIR)/test_CMSSM_database.cpp
@@ -1098,6 +1114,7 @@ $(DIR)/test_NMSSM_susy_scale_constraint.x: $(LIBNMSSM)
 
 $(DIR)/test_NMSSM_tree_level_spectrum.x: $(LIBNMSSM)
 
+$(DIR)/test_NMSSM_benchmark.x: $(LIBNMSSM)
 $(DIR)/test_NMSSM_benchmark.x.xml: $(RUN_NMSSM_EXE) $(RUN_SOFTPOINT_EXE)
 
 $(DIR)/test_NMSSM_slha_output.x.xml: $(EXAMPLES_EXE) $(DIR)/test_NMSSM_slha_output.in.spc $(RUN_SOFTPOINT_EXE)
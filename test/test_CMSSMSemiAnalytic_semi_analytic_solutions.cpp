@@ -6,6 +6,7 @@
 #include "test.hpp"
 #include "test_CMSSMSemiAnalytic.hpp"
 #include "CMSSMSemiAnalytic_semi_analytic_solutions.hpp"
+#include "stopwatch.hpp"
 
 using namespace flexiblesusy;
 
@@ -53,3 +54,63 @@ BOOST_AUTO_TEST_CASE( test_CMSSMSemiAnalytic_coefficients )
 
    BOOST_CHECK_EQUAL(get_errors(), 0);
 }
+
+namespace {
+
+/// calculates the coefficients and returns the evaluated solutions at MZ
+CMSSMSemiAnalytic_mass_eigenstates evaluate_with(
+   CMSSMSemiAnalytic_semi_analytic_solutions& solns,
+   const CMSSMSemiAnalytic_mass_eigenstates& model, double& time)
+{
+   Stopwatch stopwatch;
+   stopwatch.start();
+   solns.calculate_coefficients(model);
+   stopwatch.stop();
+   time = stopwatch.get_time_in_seconds();
+
+   CMSSMSemiAnalytic_mass_eigenstates result(model);
+   result.run_to(Electroweak_constants::MZ);
+   solns.evaluate_solutions(result);
+
+   return result;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE( test_CMSSMSemiAnalytic_concurrent_trial_runs )
+{
+   CMSSMSemiAnalytic_input_parameters input;
+   CMSSMSemiAnalytic_mass_eigenstates model(input);
+   setup_CMSSMSemiAnalytic(model, input);
+
+   const double high_scale = 2.e16;
+   model.run_to(high_scale);
+
+   Boundary_values values;
+   setup_high_scale_CMSSMSemiAnalytic(model, values);
+
+   CMSSMSemiAnalytic_semi_analytic_solutions solns;
+   solns.set_input_scale(high_scale);
+   solns.set_output_scale(Electroweak_constants::MZ);
+
+   double serial_time = 0., concurrent_time = 0.;
+
+   solns.set_concurrent_trial_runs(false);
+   const auto serial = evaluate_with(solns, model, serial_time);
+
+   solns.set_concurrent_trial_runs(true);
+   const auto concurrent = evaluate_with(solns, model, concurrent_time);
+
+   // concurrent runs yield identical coefficients
+   BOOST_CHECK_EQUAL(serial.get_MassB(), concurrent.get_MassB());
+   BOOST_CHECK_EQUAL(serial.get_BMu(), concurrent.get_BMu());
+   BOOST_CHECK_EQUAL(serial.get_mHd2(), concurrent.get_mHd2());
+   BOOST_CHECK_EQUAL(serial.get_mHu2(), concurrent.get_mHu2());
+   BOOST_CHECK(serial.get_TYu() == concurrent.get_TYu());
+   BOOST_CHECK(serial.get_mq2() == concurrent.get_mq2());
+
+   BOOST_TEST_MESSAGE("calculate_coefficients(): serial: " << serial_time
+                      << " s, concurrent: " << concurrent_time << " s");
+
+   BOOST_CHECK_EQUAL(get_errors(), 0);
+}
@@ -43,3 +43,50 @@ BOOST_AUTO_TEST_CASE( test_CMSSM_beta_function_calculation_time )
 
    BOOST_CHECK_GT(ss_time, fs_time);
 }
+
+BOOST_AUTO_TEST_CASE( test_CMSSM_fixed_size_running )
+{
+   CMSSM_input_parameters input;
+   CMSSM<Two_scale> m;
+   MssmSoftsusy s;
+   setup_CMSSM(m, s, input);
+
+   const double low_scale = m.get_scale();
+   const double high_scale = 1.0e16;
+   const int N_runs = 100;
+
+   CMSSM_soft_parameters fixed(m), dynamic(m);
+
+   Stopwatch stopwatch;
+   stopwatch.start();
+   for (int i = 0; i < N_runs; i++) {
+      fixed.set(m.get());
+      fixed.set_scale(low_scale);
+      fixed.run_to(high_scale);
+   }
+   stopwatch.stop();
+   const double fixed_time = stopwatch.get_time_in_seconds();
+
+   stopwatch.start();
+   for (int i = 0; i < N_runs; i++) {
+      dynamic.set(m.get());
+      dynamic.set_scale(low_scale);
+      dynamic.Beta_function::run(low_scale, high_scale);
+   }
+   stopwatch.stop();
+   const double dynamic_time = stopwatch.get_time_in_seconds();
+
+   BOOST_TEST_MESSAGE("Running the CMSSM parameters " << N_runs
+                 << " times with\n"
+                 "fixed-size arrays  : " << fixed_time << "s\n"
+                 "dynamic-size arrays: " << dynamic_time << "s\n");
+
+   BOOST_CHECK_EQUAL(fixed.get_scale(), high_scale);
+   BOOST_CHECK_EQUAL(dynamic.get_scale(), high_scale);
+
+   const Eigen::ArrayXd fixed_pars(fixed.get()), dynamic_pars(dynamic.get());
+
+   for (int i = 0; i < fixed_pars.size(); i++) {
+      BOOST_CHECK_EQUAL(fixed_pars(i), dynamic_pars(i));
+   }
+}
@@ -8,6 +8,11 @@
 #include "slhaea.h"
 #include "stopwatch.hpp"
 #include "logger.hpp"
+#include "lowe.h"
+#include "spectrum_generator_settings.hpp"
+#include "NMSSM_input_parameters.hpp"
+#include "NMSSM_two_scale_model.hpp"
+#include "NMSSM_two_scale_spectrum_generator.hpp"
 
 struct Data {
    Data() : number_of_valid_points(0), sum_of_times(0.) {}
@@ -151,8 +156,69 @@ void test_tanbeta_scan()
    TEST_GREATER(ss_average_time, fs_average_time);
 }
 
+/// time of n pole mass calculations with/without the coupling cache
+double time_pole_masses(const flexiblesusy::NMSSM<flexiblesusy::Two_scale>& model,
+                        bool use_coupling_cache, int n,
+                        flexiblesusy::NMSSM_physical& physical)
+{
+   flexiblesusy::Stopwatch stopwatch;
+   stopwatch.start();
+
+   for (int i = 0; i < n; i++) {
+      flexiblesusy::NMSSM<flexiblesusy::Two_scale> m(model);
+      m.do_use_coupling_cache(use_coupling_cache);
+      m.calculate_pole_masses();
+      physical = m.get_physical();
+   }
+
+   stopwatch.stop();
+
+   return stopwatch.get_time_in_seconds() / n;
+}
+
+void test_pole_mass_coupling_cache()
+{
+   using namespace flexiblesusy;
+
+   NMSSM_input_parameters input;
+   input.m0 = 200.;
+   input.m12 = 500.;
+   input.TanBeta = 10.;
+   input.Azero = -500.;
+   input.LambdaInput = 0.1;
+   input.SignvS = 1;
+
+   Spectrum_generator_settings settings;
+   settings.set(Spectrum_generator_settings::calculate_sm_masses, 1.);
+
+   NMSSM_spectrum_generator<Two_scale> spectrum_generator;
+   spectrum_generator.set_settings(settings);
+   spectrum_generator.run(softsusy::QedQcd(), input);
+
+   TEST(!spectrum_generator.get_problems().have_problem());
+
+   const auto model = spectrum_generator.get_model();
+   const int n = 10;
+
+   NMSSM_physical physical_without_cache, physical_with_cache;
+   const double time_without_cache = time_pole_masses(model, false, n, physical_without_cache);
+   const double time_with_cache = time_pole_masses(model, true, n, physical_with_cache);
+
+   INFO("Pole mass calculation (average of " << n << " calls)\n"
+        "  without coupling cache: " << time_without_cache << " s\n"
+        "  with coupling cache   : " << time_with_cache << " s");
+
+   const Eigen::ArrayXd masses_without_cache = physical_without_cache.get();
+   const Eigen::ArrayXd masses_with_cache = physical_with_cache.get();
+
+   for (int i = 0; i < masses_with_cache.size(); i++) {
+      TEST_CLOSE_REL(masses_with_cache(i), masses_without_cache(i), 1e-10);
+   }
+}
+
 int main()
 {
+   test_pole_mass_coupling_cache();
    test_tanbeta_scan();
 
    return flexiblesusy::get_errors();
@@ -11,6 +11,7 @@
 #include "ew_input.hpp"
 #include "nmssmsoftsusy.h"
 #include "NMSSM_two_scale_model.hpp"
+#include "stopwatch.hpp"
 
 using namespace flexiblesusy;
 using namespace softsusy;
@@ -291,3 +292,56 @@ BOOST_AUTO_TEST_CASE( test_NMSSM_two_loop_ewsb )
    BOOST_CHECK_CLOSE_FRACTION(vS_ss   , vS_fs   , 4.0e-8);
    BOOST_CHECK_CLOSE_FRACTION(ms2_ss  , ms2_fs  , 8.0e-8);
 }
+
+BOOST_AUTO_TEST_CASE( test_NMSSM_ewsb_dependent_masses )
+{
+   NMSSM_input_parameters input;
+   NMSSM<Two_scale> m;
+   NmssmSoftsusy s;
+   setup_NMSSM(m, s, input);
+
+   m.set_Kappa(0.1);
+   m.set_vS(5000.);
+   m.set_ms2(-Sqr(input.m0));
+   m.set_mHu2(-Sqr(input.m0));
+   m.set_mHd2(Sqr(input.m0));
+   m.calculate_DRbar_masses();
+
+   // one EWSB step changes only the EWSB output parameters
+   NMSSM<Two_scale> m_all(m), m_ewsb(m);
+   m_all.set_Kappa(0.11);
+   m_all.set_vS(5100.);
+   m_all.set_ms2(-1.1 * Sqr(input.m0));
+   m_ewsb.set_Kappa(0.11);
+   m_ewsb.set_vS(5100.);
+   m_ewsb.set_ms2(-1.1 * Sqr(input.m0));
+
+   const int repetitions = 100;
+   Stopwatch stopwatch;
+
+   stopwatch.start();
+   for (int i = 0; i < repetitions; i++) {
+      m_all.calculate_DRbar_masses();
+   }
+   stopwatch.stop();
+   const double time_all = stopwatch.get_time_in_seconds();
+
+   stopwatch.start();
+   for (int i = 0; i < repetitions; i++) {
+      m_ewsb.calculate_ewsb_dependent_DRbar_masses();
+   }
+   stopwatch.stop();
+   const double time_ewsb = stopwatch.get_time_in_seconds();
+
+   BOOST_CHECK(m_all.get_Mhh().isApprox(m_ewsb.get_Mhh(), 1e-12));
+   BOOST_CHECK(m_all.get_MAh().isApprox(m_ewsb.get_MAh(), 1e-12));
+   BOOST_CHECK(m_all.get_MHpm().isApprox(m_ewsb.get_MHpm(), 1e-12));
+   BOOST_CHECK(m_all.get_MChi().isApprox(m_ewsb.get_MChi(), 1e-12));
+   BOOST_CHECK(m_all.get_MCha().isApprox(m_ewsb.get_MCha(), 1e-12));
+   BOOST_CHECK(m_all.get_MSd().isApprox(m_ewsb.get_MSd(), 1e-12));
+   BOOST_CHECK(m_all.get_MSu().isApprox(m_ewsb.get_MSu(), 1e-12));
+   BOOST_CHECK_EQUAL(m_all.get_MVZ(), m_ewsb.get_MVZ());
+
+   BOOST_TEST_MESSAGE("DR-bar masses (" << repetitions << "x): all "
+                      << time_all << "s, EWSB-dependent " << time_ewsb << "s");
+}
@@ -0,0 +1,176 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_betafunction_workspace
+
+#include <boost/test/unit_test.hpp>
+
+#include "basic_rk_integrator.hpp"
+#include "betafunction.hpp"
+#include "rk.hpp"
+#include "stopwatch.hpp"
+
+#include <Eigen/Core>
+
+#include <cmath>
+#include <cstddef>
+
+namespace {
+
+long number_of_allocations = 0;
+
+} // anonymous namespace
+
+#ifdef __GLIBC__
+
+// count all heap allocations, including those made by Eigen
+
+#define COUNT_ALLOCATIONS 1
+
+extern "C" void* __libc_malloc(std::size_t);
+
+extern "C" void* malloc(std::size_t size)
+{
+   ++number_of_allocations;
+   return __libc_malloc(size);
+}
+
+#endif
+
+using namespace flexiblesusy;
+
+namespace {
+
+const int N = 300;
+
+Eigen::ArrayXd betas(const Eigen::ArrayXd& pars)
+{
+   Eigen::ArrayXd beta(pars.size());
+   for (int i = 0; i < pars.rows(); i++)
+      beta(i) = pars(i) * pars(i) * 0.01 + 0.005 * pars(pars.rows() - 1 - i);
+   return beta;
+}
+
+/// model which only implements the allocating interface
+class Model : public Beta_function {
+public:
+   Model() : pars(Eigen::ArrayXd::LinSpaced(N, 0.01, 0.1)) {
+      set_scale(100.);
+      set_number_of_parameters(N);
+      set_loops(1);
+   }
+   virtual ~Model() = default;
+   virtual Eigen::ArrayXd get() const override { return pars; }
+   virtual void set(const Eigen::ArrayXd& s) override { pars = s; }
+   virtual Eigen::ArrayXd beta() const override { return betas(pars); }
+protected:
+   Eigen::ArrayXd pars;
+};
+
+/// model which writes into caller-provided buffers
+class Model_in_place : public Model {
+public:
+   virtual ~Model_in_place() = default;
+   virtual void get_into(Eigen::ArrayXd& p) const override { p = pars; }
+   virtual void beta_into(Eigen::ArrayXd& beta) const override {
+      for (int i = 0; i < pars.rows(); i++)
+         beta(i) = pars(i) * pars(i) * 0.01 + 0.005 * pars(pars.rows() - 1 - i);
+   }
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE( test_same_result_as_basic_integrator )
+{
+   Model_in_place model;
+   Eigen::ArrayXd y(model.get());
+
+   const double tol = 1e-6;
+   const double start = std::log(100.), end = std::log(1e10);
+   runge_kutta::Basic_rk_integrator<Eigen::ArrayXd> integrator;
+   integrator(start, end, y, [] (double, const Eigen::ArrayXd& p) { return betas(p); }, tol);
+
+   model.run_to(1e10, tol);
+
+   const Eigen::ArrayXd pars(model.get());
+
+   for (int i = 0; i < N; i++)
+      BOOST_CHECK_EQUAL(pars(i), y(i));
+}
+
+BOOST_AUTO_TEST_CASE( test_allocations )
+{
+   Model model;
+   Model_in_place model_in_place;
+
+   // first run sizes the workspace
+   model.run_to(1000.);
+   model_in_place.run_to(1000.);
+
+   long allocs_before = number_of_allocations;
+   model.run_to(1e10);
+   const long allocs_default = number_of_allocations - allocs_before;
+
+   allocs_before = number_of_allocations;
+   model_in_place.run_to(1e10);
+   const long allocs_in_place = number_of_allocations - allocs_before;
+
+   BOOST_TEST_MESSAGE("allocations per run_to() (allocating interface): " << allocs_default);
+   BOOST_TEST_MESSAGE("allocations per run_to() (in-place interface)  : " << allocs_in_place);
+
+#ifdef COUNT_ALLOCATIONS
+   BOOST_CHECK_GT(allocs_default, 0);
+   BOOST_CHECK_EQUAL(allocs_in_place, 0);
+#endif
+
+   for (int i = 0; i < N; i++)
+      BOOST_CHECK_EQUAL(model.get()(i), model_in_place.get()(i));
+}
+
+BOOST_AUTO_TEST_CASE( test_copy_does_not_copy_workspace )
+{
+   Model_in_place model;
+   model.run_to(1000.);
+
+   const long allocs_before = number_of_allocations;
+   Model_in_place copy(model);
+   const long allocs_copy = number_of_allocations - allocs_before;
+
+#ifdef COUNT_ALLOCATIONS
+   // only the parameter array itself is copied
+   BOOST_CHECK_EQUAL(allocs_copy, 1);
+#endif
+
+   copy.run_to(1e5);
+   model.run_to(1e5);
+
+   for (int i = 0; i < N; i++)
+      BOOST_CHECK_EQUAL(model.get()(i), copy.get()(i));
+}
+
+BOOST_AUTO_TEST_CASE( test_benchmark )
+{
+   const int n_runs = 1000;
+   Model model;
+   Model_in_place model_in_place;
+
+   Stopwatch sw;
+
+   sw.start();
+   for (int i = 0; i < n_runs; i++) {
+      model.run_to(i % 2 ? 100. : 1e10);
+   }
+   sw.stop();
+   const double time_default = sw.get_time_in_seconds();
+
+   sw.start();
+   for (int i = 0; i < n_runs; i++) {
+      model_in_place.run_to(i % 2 ? 100. : 1e10);
+   }
+   sw.stop();
+   const double time_in_place = sw.get_time_in_seconds();
+
+   BOOST_TEST_MESSAGE("time for " << n_runs << " runs (allocating interface): " << time_default << "s");
+   BOOST_TEST_MESSAGE("time for " << n_runs << " runs (in-place interface)  : " << time_in_place << "s");
+
+   for (int i = 0; i < N; i++)
+      BOOST_CHECK_EQUAL(model.get()(i), model_in_place.get()(i));
+}
@@ -0,0 +1,285 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_columnar_file
+
+#include <boost/test/unit_test.hpp>
+
+#include "columnar_file.hpp"
+#include "error.hpp"
+#include "stopwatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace flexiblesusy;
+
+namespace {
+
+const std::vector<std::string> names = {"index", "x", "y"};
+
+Eigen::ArrayXd make_row(int index)
+{
+   Eigen::ArrayXd row(3);
+   row << index, 0.1 * index, std::exp(-index);
+   return row;
+}
+
+void remove_file(const std::string& file_name)
+{
+   std::remove(file_name.c_str());
+}
+
+/// removes the file before the test and at the end of the test
+class Temporary_file {
+public:
+   explicit Temporary_file(const std::string& file_name_) : file_name(file_name_) { remove_file(file_name); }
+   ~Temporary_file() { remove_file(file_name); }
+   Temporary_file(const Temporary_file&) = delete;
+   Temporary_file& operator=(const Temporary_file&) = delete;
+private:
+   std::string file_name;
+};
+
+long long file_size(const std::string& file_name)
+{
+   std::ifstream ifs(file_name, std::ios::binary | std::ios::ate);
+   return ifs.tellg();
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE( test_write_read )
+{
+   const std::string file_name("test/test_columnar_file_write_read.bin");
+   const Temporary_file tmp(file_name);
+
+   {
+      columnar::Writer writer(file_name, 4);
+      for (int i = 0; i < 10; i++) {
+         writer.append(names, make_row(i));
+      }
+   }
+
+   columnar::Reader reader(file_name);
+
+   BOOST_CHECK(reader.get_names() == names);
+   BOOST_CHECK_EQUAL(reader.get_number_of_rows(), 10);
+   BOOST_CHECK_EQUAL(reader.find_column("y"), 2);
+   BOOST_CHECK_EQUAL(reader.find_column("z"), -1);
+
+   for (int i = 0; i < 10; i++) {
+      BOOST_CHECK((reader.get_row(i) == make_row(i)).all());
+      BOOST_CHECK_EQUAL(reader.get(i, 2), std::exp(-i));
+   }
+
+   BOOST_CHECK((reader.get_row(-1) == make_row(9)).all());
+   BOOST_CHECK((reader.get_column(0) == Eigen::ArrayXd::LinSpaced(10, 0., 9.)).all());
+
+   BOOST_CHECK_THROW(reader.get_row(10), OutOfBoundsError);
+   BOOST_CHECK_THROW(reader.get(0, 3), OutOfBoundsError);
+}
+
+BOOST_AUTO_TEST_CASE( test_append )
+{
+   const std::string file_name("test/test_columnar_file_append.bin");
+   const Temporary_file tmp(file_name);
+
+   for (int i = 0; i < 5; i++) {
+      // one writer per point, as in a run with one point per process
+      columnar::Writer writer(file_name);
+      writer.append(names, make_row(i));
+   }
+
+   {
+      columnar::Writer writer(file_name);
+      BOOST_CHECK(writer.get_names() == names);
+      // different schema
+      BOOST_CHECK_THROW(writer.append({"index", "x"}, Eigen::ArrayXd::Zero(2)), SetupError);
+      BOOST_CHECK_THROW(writer.append({"index", "x", "z"}, make_row(5)), SetupError);
+   }
+
+   columnar::Reader reader(file_name);
+
+   BOOST_CHECK_EQUAL(reader.get_number_of_rows(), 5);
+   for (int i = 0; i < 5; i++) {
+      BOOST_CHECK((reader.get_row(i) == make_row(i)).all());
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test_incomplete_chunk )
+{
+   const std::string file_name("test/test_columnar_file_incomplete.bin");
+   const Temporary_file tmp(file_name);
+
+   {
+      columnar::Writer writer(file_name, 2);
+      for (int i = 0; i < 4; i++) {
+         writer.append(names, make_row(i));
+      }
+   }
+
+   // simulate an interrupted writer
+   {
+      std::ofstream ofs(file_name, std::ios::binary | std::ios::app);
+      const std::uint64_t rows = 2;
+      const double value = 1.;
+      ofs.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+      ofs.write(reinterpret_cast<const char*>(&value), sizeof(value));
+   }
+
+   {
+      columnar::Reader reader(file_name);
+      BOOST_CHECK_EQUAL(reader.get_number_of_rows(), 4);
+      BOOST_CHECK((reader.get_row(3) == make_row(3)).all());
+   }
+
+   // the incomplete chunk is removed before appending
+   {
+      columnar::Writer writer(file_name, 2);
+      // header (with 16 bytes of names) and two chunks of two rows
+      BOOST_CHECK_EQUAL(file_size(file_name), 8 + 2*8 + 16 + 2*(8 + 2*3*8));
+      for (int i = 4; i < 6; i++) {
+         writer.append(names, make_row(i));
+      }
+   }
+
+   columnar::Reader reader(file_name);
+   BOOST_CHECK_EQUAL(reader.get_number_of_rows(), 6);
+   for (int i = 0; i < 6; i++) {
+      BOOST_CHECK((reader.get_row(i) == make_row(i)).all());
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test_concurrent_writers )
+{
+   const std::string file_name("test/test_columnar_file_concurrent.bin");
+   const Temporary_file tmp(file_name);
+
+   const int number_of_processes = 4;
+   const int rows_per_process = 100;
+   std::vector<pid_t> pids;
+
+   for (int p = 0; p < number_of_processes; p++) {
+      const pid_t pid = fork();
+      if (pid == 0) {
+         columnar::Writer writer(file_name, 1);
+         for (int i = 0; i < rows_per_process; i++) {
+            writer.append(names, make_row(p*rows_per_process + i));
+         }
+         _exit(0);
+      }
+      pids.push_back(pid);
+   }
+
+   for (const auto pid: pids) {
+      int status = 0;
+      waitpid(pid, &status, 0);
+      BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+   }
+
+   columnar::Reader reader(file_name);
+   BOOST_REQUIRE_EQUAL(reader.get_number_of_rows(), number_of_processes*rows_per_process);
+
+   Eigen::ArrayXd index = reader.get_column(0);
+   std::sort(index.data(), index.data() + index.size());
+   BOOST_CHECK((index == Eigen::ArrayXd::LinSpaced(index.size(), 0., index.size() - 1.)).all());
+
+   for (long long r = 0; r < reader.get_number_of_rows(); r++) {
+      const auto row = reader.get_row(r);
+      BOOST_CHECK((row == make_row(static_cast<int>(row(0)))).all());
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test_invalid_file )
+{
+   const std::string file_name("test/test_columnar_file_invalid.bin");
+   const Temporary_file tmp(file_name);
+
+   BOOST_CHECK_THROW(columnar::Reader reader(file_name), ReadError);
+
+   {
+      std::ofstream ofs(file_name);
+      ofs << "Block MASS\n";
+   }
+
+   BOOST_CHECK_THROW(columnar::Reader reader(file_name), ReadError);
+   BOOST_CHECK_THROW(columnar::Writer writer(file_name), ReadError);
+}
+
+/**
+ * Compares writing many rows to a columnar file with writing the
+ * same numbers as text in SLHA number format.
+ */
+BOOST_AUTO_TEST_CASE( test_benchmark )
+{
+   const std::string bin_file("test/test_columnar_file_benchmark.bin");
+   const std::string txt_file("test/test_columnar_file_benchmark.txt");
+   const Temporary_file tmp_bin(bin_file), tmp_txt(txt_file);
+
+   const int number_of_rows = 10000;
+   const int number_of_columns = 200;
+   std::vector<std::string> columns;
+   for (int i = 0; i < number_of_columns; i++) {
+      columns.push_back("c" + std::to_string(i));
+   }
+   Eigen::ArrayXd row = Eigen::ArrayXd::LinSpaced(number_of_columns, 0., 1.);
+
+   Stopwatch sw;
+
+   sw.start();
+   {
+      columnar::Writer writer(bin_file);
+      for (int i = 0; i < number_of_rows; i++) {
+         row(0) = i;
+         writer.append(columns, row);
+      }
+   }
+   sw.stop();
+   const double time_bin = sw.get_time_in_seconds();
+
+   sw.start();
+   {
+      std::ofstream ofs(txt_file);
+      for (int i = 0; i < number_of_rows; i++) {
+         row(0) = i;
+         ofs << "Block POINT\n";
+         for (int k = 0; k < number_of_columns; k++) {
+            ofs << std::setw(6) << k << "   " << std::scientific
+                << std::setprecision(8) << std::setw(16) << row(k)
+                << "   # " << columns[k] << '\n';
+         }
+      }
+   }
+   sw.stop();
+   const double time_txt = sw.get_time_in_seconds();
+
+   sw.start();
+   double sum = 0.;
+   {
+      columnar::Reader reader(bin_file);
+      sum = reader.get_column(0).sum();
+   }
+   sw.stop();
+   const double time_read = sw.get_time_in_seconds();
+
+   BOOST_CHECK_EQUAL(sum, 0.5 * number_of_rows * (number_of_rows - 1));
+
+   BOOST_TEST_MESSAGE("writing " << number_of_rows << " rows with "
+                      << number_of_columns << " columns:\n"
+                      << "   columnar: " << time_bin << "s, "
+                      << file_size(bin_file) << " bytes\n"
+                      << "   text    : " << time_txt << "s, "
+                      << file_size(txt_file) << " bytes\n"
+                      << "reading one column: " << time_read << "s");
+
+   BOOST_CHECK_LT(file_size(bin_file), file_size(txt_file));
+}
@@ -0,0 +1,63 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_coupling_table
+
+#include <boost/test/unit_test.hpp>
+
+#include "coupling_table.hpp"
+
+#include <complex>
+
+using namespace flexiblesusy;
+
+BOOST_AUTO_TEST_CASE( test_no_index )
+{
+   Coupling_table<double> table;
+
+   BOOST_CHECK_EQUAL(table.size(), 1);
+   BOOST_CHECK(table.empty());
+
+   table.fill([] () { return 2.; });
+
+   BOOST_CHECK(!table.empty());
+   BOOST_CHECK_EQUAL(table(), 2.);
+}
+
+BOOST_AUTO_TEST_CASE( test_fill )
+{
+   Coupling_table<std::complex<double>,2,3,4> table;
+
+   BOOST_CHECK_EQUAL(table.size(), 24);
+
+   int calls = 0;
+   const auto coupling = [&calls] (int i, int j, int k) {
+      calls++;
+      return std::complex<double>(i + 10*j + 100*k, i*j*k);
+   };
+
+   table.fill(coupling);
+
+   BOOST_CHECK_EQUAL(calls, 24);
+
+   for (int i = 0; i < 2; i++) {
+      for (int j = 0; j < 3; j++) {
+         for (int k = 0; k < 4; k++) {
+            BOOST_CHECK_EQUAL(table(i, j, k), coupling(i, j, k));
+         }
+      }
+   }
+
+   table.clear();
+   BOOST_CHECK(table.empty());
+}
+
+BOOST_AUTO_TEST_CASE( test_copy )
+{
+   Coupling_table<double,3> table;
+   table.fill([] (int i) { return 1. * i; });
+
+   const Coupling_table<double,3> copy(table);
+   table.clear();
+
+   BOOST_CHECK(table.empty());
+   BOOST_CHECK_EQUAL(copy(2), 2.);
+}
@@ -0,0 +1,178 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_database
+
+#include <boost/test/unit_test.hpp>
+
+#include "database.hpp"
+#include "stopwatch.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace flexiblesusy;
+
+namespace {
+
+const std::vector<std::string> names = {"index", "x", "y"};
+
+Eigen::ArrayXd make_row(int index)
+{
+   Eigen::ArrayXd row(3);
+   row << index, 0.1 * index, std::exp(-index);
+   return row;
+}
+
+void remove_file(const std::string& file_name)
+{
+   std::remove(file_name.c_str());
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE( test_insert_extract )
+{
+   const std::string db_file("test/test_database_insert.db");
+   remove_file(db_file);
+
+   {
+      database::Database db(db_file);
+      for (int i = 0; i < 10; i++) {
+         db.insert("Point", names, make_row(i));
+      }
+      BOOST_CHECK((db.extract("Point", 3) == make_row(3)).all());
+   }
+
+   database::Database db(db_file);
+   BOOST_CHECK((db.extract("Point", 0) == make_row(0)).all());
+   BOOST_CHECK((db.extract("Point", -1) == make_row(9)).all());
+   BOOST_CHECK((db.extract("Point", -2) == make_row(8)).all());
+}
+
+BOOST_AUTO_TEST_CASE( test_transactions )
+{
+   const std::string db_file("test/test_database_transactions.db");
+   remove_file(db_file);
+
+   {
+      database::Database db(db_file);
+      db.set_rows_per_transaction(4);
+      BOOST_CHECK_EQUAL(db.get_rows_per_transaction(), 4);
+      for (int i = 0; i < 10; i++) {
+         db.insert("Point", names, make_row(i));
+      }
+      // uncommitted rows are visible from the same connection
+      BOOST_CHECK((db.extract("Point", -1) == make_row(9)).all());
+      // remaining rows are committed in the destructor
+   }
+
+   database::Database db(db_file);
+   BOOST_CHECK((db.extract("Point", 9) == make_row(9)).all());
+   BOOST_CHECK((db.extract("Point", -1) == make_row(9)).all());
+}
+
+BOOST_AUTO_TEST_CASE( test_nan )
+{
+   const std::string db_file("test/test_database_nan.db");
+   remove_file(db_file);
+
+   database::Database db(db_file);
+   Eigen::ArrayXd row = make_row(1);
+   row(1) = std::numeric_limits<double>::quiet_NaN();
+   db.insert("Point", names, row);
+
+   const Eigen::ArrayXd result = db.extract("Point", 0);
+
+   BOOST_REQUIRE_EQUAL(result.size(), 3);
+   BOOST_CHECK_EQUAL(result(0), row(0));
+   BOOST_CHECK(std::isnan(result(1)));
+   BOOST_CHECK_EQUAL(result(2), row(2));
+}
+
+BOOST_AUTO_TEST_CASE( test_writer_multiple_threads )
+{
+   const std::string db_file("test/test_database_writer.db");
+   remove_file(db_file);
+
+   const int number_of_threads = 4;
+   const int rows_per_thread = 250;
+
+   {
+      database::Database_writer writer(db_file, 100);
+
+      std::vector<std::thread> threads;
+      for (int t = 0; t < number_of_threads; t++) {
+         threads.emplace_back([&writer, t] {
+            for (int i = 0; i < rows_per_thread; i++) {
+               writer.insert("Point", names, make_row(t * rows_per_thread + i));
+            }
+         });
+      }
+      for (auto& t: threads) {
+         t.join();
+      }
+
+      writer.flush();
+   }
+
+   database::Database db(db_file);
+   const int n = number_of_threads * rows_per_thread;
+
+   // all rows are written exactly once
+   std::vector<int> found(n, 0);
+   for (int i = 0; i < n; i++) {
+      const Eigen::ArrayXd row = db.extract("Point", i);
+      BOOST_REQUIRE_EQUAL(row.size(), 3);
+      const int index = static_cast<int>(row(0));
+      BOOST_REQUIRE(index >= 0 && index < n);
+      BOOST_CHECK((row == make_row(index)).all());
+      found[index]++;
+   }
+
+   for (int i = 0; i < n; i++) {
+      BOOST_CHECK_EQUAL(found[i], 1);
+   }
+
+   BOOST_CHECK_EQUAL(db.extract("Point", n).size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( test_benchmark )
+{
+   const std::string db_file("test/test_database_benchmark.db");
+   const int number_of_rows = 2000;
+   Eigen::ArrayXd row = Eigen::ArrayXd::LinSpaced(200, 0., 1.);
+   std::vector<std::string> columns;
+   for (int i = 0; i < row.size(); i++) {
+      columns.push_back("c" + std::to_string(i));
+   }
+
+   const auto time_insert = [&] (std::size_t rows_per_transaction) {
+      remove_file(db_file);
+      Stopwatch sw;
+      sw.start();
+      {
+         database::Database db(db_file);
+         db.set_rows_per_transaction(rows_per_transaction);
+         for (int i = 0; i < number_of_rows; i++) {
+            row(0) = i;
+            db.insert("Point", columns, row);
+         }
+      }
+      sw.stop();
+      return sw.get_time_in_seconds();
+   };
+
+   const double time_single = time_insert(1);
+   const double time_batched = time_insert(1000);
+
+   BOOST_TEST_MESSAGE("writing " << number_of_rows << " rows with "
+                      << row.size() << " columns:\n"
+                      << "   one row per transaction: " << time_single << "s\n"
+                      << "   1000 rows per transaction: " << time_batched << "s");
+
+   BOOST_CHECK_LT(time_batched, time_single);
+
+   remove_file(db_file);
+}
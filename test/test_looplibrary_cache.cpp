@@ -0,0 +1,180 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_looplibrary_cache
+
+#include <boost/test/unit_test.hpp>
+#include "loop_libraries/library_cache.hpp"
+#include "loop_libraries/library_softsusy.hpp"
+#include "loop_libraries/loop_library.hpp"
+#include "stopwatch.hpp"
+
+#include <memory>
+#include <thread>
+
+using namespace flexiblesusy;
+
+namespace {
+
+looplibrary::Cache make_cache()
+{
+   return looplibrary::Cache(std::make_unique<looplibrary::Softsusy>());
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE( test_values )
+{
+   looplibrary::Softsusy lib;
+   auto cache = make_cache();
+   looplibrary::Cache::clear();
+   looplibrary::Cache::reset_statistics();
+
+   const double scl2 = 100.*100.;
+   const std::complex<double> p2 = 50.*50., m12 = 20.*20., m22 = 300.*300.;
+
+   for (int i = 0; i < 2; i++) {
+      BOOST_CHECK_EQUAL(cache.A0(m12, scl2), lib.A0(m12, scl2));
+      BOOST_CHECK_EQUAL(cache.B0(p2, m12, m22, scl2), lib.B0(p2, m12, m22, scl2));
+      BOOST_CHECK_EQUAL(cache.B1(p2, m12, m22, scl2), lib.B1(p2, m12, m22, scl2));
+      BOOST_CHECK_EQUAL(cache.B00(p2, m12, m22, scl2), lib.B00(p2, m12, m22, scl2));
+
+      looplibrary::Bcoeff_t b_cache{}, b_lib{};
+      cache.B(b_cache, p2, m12, m22, scl2);
+      lib.B(b_lib, p2, m12, m22, scl2);
+      BOOST_CHECK(b_cache == b_lib);
+   }
+
+   const auto statistics = looplibrary::Cache::get_statistics();
+   BOOST_CHECK_EQUAL(statistics.misses, 5);
+   BOOST_CHECK_EQUAL(statistics.hits, 5);
+
+   // different arguments are not mixed up
+   BOOST_CHECK_EQUAL(cache.B0(p2, m22, m12, scl2), lib.B0(p2, m22, m12, scl2));
+   BOOST_CHECK_EQUAL(cache.B0(p2, m12, m22, 2*scl2), lib.B0(p2, m12, m22, 2*scl2));
+   BOOST_CHECK_EQUAL(looplibrary::Cache::get_statistics().misses, 7);
+
+   // three-point functions are not cached
+   BOOST_CHECK_EQUAL(cache.C0(p2, p2, p2, m12, m22, m22, scl2),
+                     lib.C0(p2, p2, p2, m12, m22, m22, scl2));
+   BOOST_CHECK_EQUAL(looplibrary::Cache::get_statistics().misses, 7);
+
+   looplibrary::Cache::clear();
+   cache.B0(p2, m12, m22, scl2);
+   BOOST_CHECK_EQUAL(looplibrary::Cache::get_statistics().misses, 8);
+}
+
+BOOST_AUTO_TEST_CASE( test_per_thread_storage )
+{
+   auto cache = make_cache();
+   looplibrary::Cache::clear();
+   looplibrary::Cache::reset_statistics();
+
+   cache.B0(1., 2., 3., 4.);
+   cache.B0(1., 2., 3., 4.);
+
+   looplibrary::Cache::Statistics other;
+   std::thread t([&] {
+      cache.B0(1., 2., 3., 4.);
+      other = looplibrary::Cache::get_statistics();
+   });
+   t.join();
+
+   BOOST_CHECK_EQUAL(other.hits, 0);
+   BOOST_CHECK_EQUAL(other.misses, 1);
+   BOOST_CHECK_EQUAL(looplibrary::Cache::get_statistics().hits, 1);
+   BOOST_CHECK_EQUAL(looplibrary::Cache::get_statistics().misses, 1);
+}
+
+BOOST_AUTO_TEST_CASE( test_max_entries )
+{
+   looplibrary::Cache cache(std::make_unique<looplibrary::Softsusy>(), 10);
+   looplibrary::Cache::clear();
+   looplibrary::Cache::reset_statistics();
+
+   for (int i = 0; i < 11; i++) {
+      cache.A0(1. + i, 4.);
+   }
+
+   // storage has been cleared when the 11th value was added
+   cache.A0(1., 4.);
+   BOOST_CHECK_EQUAL(looplibrary::Cache::get_statistics().hits, 0);
+   cache.A0(11., 4.);
+   BOOST_CHECK_EQUAL(looplibrary::Cache::get_statistics().hits, 1);
+}
+
+BOOST_AUTO_TEST_CASE( test_loop_library )
+{
+   Loop_library::set(0);
+   BOOST_CHECK(!Loop_library::is_cache_enabled());
+   BOOST_CHECK(dynamic_cast<looplibrary::Softsusy*>(&Loop_library::get()));
+
+   Loop_library::enable_cache(true);
+   BOOST_CHECK(Loop_library::is_cache_enabled());
+   BOOST_CHECK(dynamic_cast<looplibrary::Cache*>(&Loop_library::get()));
+   BOOST_CHECK(Loop_library::get_type() == Loop_library::Library::Softsusy);
+
+   Loop_library::clear_cache();
+   looplibrary::Cache::reset_statistics();
+   Loop_library::get().B0(1., 2., 3., 4.);
+   Loop_library::get().B0(1., 2., 3., 4.);
+   BOOST_CHECK_EQUAL(looplibrary::Cache::get_statistics().hits, 1);
+
+   Loop_library::enable_cache(false);
+   BOOST_CHECK(dynamic_cast<looplibrary::Softsusy*>(&Loop_library::get()));
+}
+
+BOOST_AUTO_TEST_CASE( test_benchmark )
+{
+   looplibrary::Softsusy lib;
+   auto cache = make_cache();
+   looplibrary::Cache::clear();
+
+   const int n_masses = 20, n_repetitions = 10;
+   const double scl2 = 1e6;
+
+   const auto run = [&] (looplibrary::Loop_library_interface& l) {
+      std::complex<double> sum = 0.;
+      for (int r = 0; r < n_repetitions; r++) {
+         for (int i = 1; i <= n_masses; i++) {
+            for (int k = 1; k <= n_masses; k++) {
+               sum += l.B0(1e4, 1e4*i, 1e4*k, scl2) + l.B1(1e4, 1e4*i, 1e4*k, scl2);
+            }
+         }
+      }
+      return sum;
+   };
+
+   Stopwatch sw;
+   sw.start();
+   const auto sum_lib = run(lib);
+   sw.stop();
+   const double time_lib = sw.get_time_in_seconds();
+
+   sw.start();
+   const auto sum_cache = run(cache);
+   sw.stop();
+   const double time_cache = sw.get_time_in_seconds();
+
+   BOOST_CHECK_EQUAL(sum_lib, sum_cache);
+
+   BOOST_TEST_MESSAGE("B0 + B1 with " << n_repetitions << " repetitions:\n"
+                      << "   without cache: " << time_lib << "s\n"
+                      << "   with cache: " << time_cache << "s");
+}
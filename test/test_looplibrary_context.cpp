@@ -0,0 +1,117 @@
+// ====================================================================
+// This file is part of FlexibleSUSY.
+//
+// FlexibleSUSY is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// FlexibleSUSY is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FlexibleSUSY.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_looplibrary_context
+
+#include <boost/test/unit_test.hpp>
+#include "loop_libraries/library_cache.hpp"
+#include "loop_libraries/library_softsusy.hpp"
+#include "loop_libraries/loop_library.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace flexiblesusy;
+
+BOOST_AUTO_TEST_CASE( test_guard )
+{
+   Loop_library::set(0);
+   auto* global = &Loop_library::get();
+
+   BOOST_CHECK(Loop_library::get_context() == nullptr);
+
+   Loop_library_context context(0);
+   BOOST_CHECK(!context.empty());
+   BOOST_CHECK(context.get_type() == Loop_library::Library::Softsusy);
+   BOOST_CHECK(&context.get() != global);
+
+   {
+      Loop_library_context_guard guard(context);
+      BOOST_CHECK(Loop_library::get_context() == &context);
+      BOOST_CHECK(&Loop_library::get() == &context.get());
+
+      {
+         Loop_library_context other(0, true);
+         Loop_library_context_guard other_guard(other);
+         BOOST_CHECK(&Loop_library::get() == &other.get());
+         BOOST_CHECK(dynamic_cast<looplibrary::Cache*>(&Loop_library::get()));
+      }
+
+      // previous context is restored
+      BOOST_CHECK(&Loop_library::get() == &context.get());
+   }
+
+   BOOST_CHECK(Loop_library::get_context() == nullptr);
+   BOOST_CHECK(&Loop_library::get() == global);
+}
+
+BOOST_AUTO_TEST_CASE( test_empty_context )
+{
+   Loop_library::set(0);
+
+   Loop_library_context context;
+   BOOST_CHECK(context.empty());
+   BOOST_CHECK(&context.get() == &Loop_library::get());
+
+   Loop_library_context_guard guard(context);
+   BOOST_CHECK(Loop_library::get_type() == Loop_library::Library::Softsusy);
+   BOOST_CHECK(&Loop_library::get() == &context.get());
+}
+
+BOOST_AUTO_TEST_CASE( test_copy_shares_library )
+{
+   Loop_library_context context(0);
+   Loop_library_context copy(context);
+
+   BOOST_CHECK(&copy.get() == &context.get());
+}
+
+BOOST_AUTO_TEST_CASE( test_concurrent_contexts )
+{
+   const int number_of_threads = 4;
+   std::vector<Loop_library_context> contexts;
+   for (int i = 0; i < number_of_threads; i++) {
+      contexts.emplace_back(0, i % 2 == 0);
+   }
+
+   std::vector<int> uses_own_library(number_of_threads, 0);
+   std::vector<std::complex<double>> b0(number_of_threads);
+   std::vector<std::thread> threads;
+
+   for (int i = 0; i < number_of_threads; i++) {
+      threads.emplace_back([&, i] {
+         Loop_library_context_guard guard(contexts[i]);
+         for (int k = 0; k < 1000; k++) {
+            b0[i] = Loop_library::get().B0(100., 200., 300., 400.);
+         }
+         uses_own_library[i] = &Loop_library::get() == &contexts[i].get();
+      });
+   }
+
+   for (auto& t: threads) {
+      t.join();
+   }
+
+   const auto expected = looplibrary::Softsusy().B0(100., 200., 300., 400.);
+
+   for (int i = 0; i < number_of_threads; i++) {
+      BOOST_CHECK(uses_own_library[i]);
+      BOOST_CHECK_EQUAL(b0[i], expected);
+   }
+}
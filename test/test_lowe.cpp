@@ -5,6 +5,7 @@
 #include "wrappers.hpp"
 #include "lowe.h"
 #include "conversion.hpp"
+#include "qedqcd_cache.hpp"
 
 using namespace softsusy;
 
@@ -56,3 +57,67 @@ BOOST_AUTO_TEST_CASE( test_to_recall )
    BOOST_TEST_MESSAGE(lowe_Mz);
    BOOST_TEST_MESSAGE(lowe_Mz_new);
 }
+
+BOOST_AUTO_TEST_CASE( test_to_cache )
+{
+   auto& cache = QedQcd::to_cache();
+   cache.clear();
+
+   QedQcd lowe;
+   lowe.setPoleMt(173.5);
+   QedQcd lowe_cached(lowe), lowe_uncached(lowe), lowe_other(lowe);
+
+   lowe.to(lowe.displayPoleMZ());
+   BOOST_CHECK_EQUAL(cache.size(), 1);
+   BOOST_CHECK_EQUAL(cache.get_hits(), 0);
+   BOOST_CHECK_EQUAL(cache.get_misses(), 1);
+
+   lowe_cached.to(lowe_cached.displayPoleMZ());
+   BOOST_CHECK_EQUAL(cache.size(), 1);
+   BOOST_CHECK_EQUAL(cache.get_hits(), 1);
+
+   cache.set_enabled(false);
+   lowe_uncached.to(lowe_uncached.displayPoleMZ());
+   cache.set_enabled(true);
+   BOOST_CHECK_EQUAL(cache.get_hits(), 1);
+
+   // cached result is identical to the one of a new iteration
+   BOOST_CHECK((lowe.get() == lowe_cached.get()).all());
+   BOOST_CHECK((lowe.get() == lowe_uncached.get()).all());
+   BOOST_CHECK_EQUAL(lowe.get_scale(), lowe_cached.get_scale());
+   BOOST_CHECK_EQUAL(lowe.displayPoleMb(), lowe_cached.displayPoleMb());
+
+   // different input parameters or target scale
+   lowe_other.setAlphaSInput(0.119);
+   lowe_other.to(lowe_other.displayPoleMZ());
+   lowe_cached.to(100.);
+   BOOST_CHECK_EQUAL(cache.size(), 3);
+   BOOST_CHECK_EQUAL(cache.get_hits(), 1);
+   BOOST_CHECK_NE(lowe_other.displayAlpha(ALPHAS), lowe.displayAlpha(ALPHAS));
+
+   cache.clear();
+   BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( test_run_to_cached )
+{
+   auto& cache = QedQcd::running_cache();
+   cache.clear();
+
+   QedQcd lowe;
+   lowe.setPoleMt(173.5);
+   lowe.to(lowe.displayPoleMZ());
+   QedQcd lowe_cached(lowe), lowe_uncached(lowe);
+
+   lowe.run_to_cached(5., 1e-5);
+   lowe_cached.run_to_cached(5., 1e-5);
+   lowe_uncached.run_to(5., 1e-5);
+
+   BOOST_CHECK_EQUAL(cache.size(), 1);
+   BOOST_CHECK_EQUAL(cache.get_hits(), 1);
+   BOOST_CHECK((lowe.get() == lowe_cached.get()).all());
+   BOOST_CHECK((lowe.get() == lowe_uncached.get()).all());
+   BOOST_CHECK_EQUAL(lowe_cached.get_scale(), 5.);
+
+   cache.clear();
+}
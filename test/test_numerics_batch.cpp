@@ -0,0 +1,174 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_numerics_batch
+
+#include <boost/test/unit_test.hpp>
+
+#include "numerics.h"
+#include "stopwatch.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace flexiblesusy;
+
+namespace {
+
+const std::vector<double> masses = {
+   0., 1e-3, 0.1, 1., 91., 91. + 1e-9, 91.1, 100., 173., 500., 1000., 1000.5, 5000., -100.
+};
+
+const std::vector<double> momenta = { 0., 1e-3, 1., 10., 91., 173., 500., 1000., 3000. };
+
+/// all pairs of masses
+void make_pairs(const std::vector<double>& ms, std::vector<double>& m1, std::vector<double>& m2)
+{
+   for (const auto x1: ms) {
+      for (const auto x2: ms) {
+         m1.push_back(x1);
+         m2.push_back(x2);
+      }
+   }
+}
+
+template <typename Scalar, typename Batch>
+void check_pairs(Scalar scalar, Batch batch, double q, double tol,
+                 const std::vector<double>& ms = masses,
+                 const std::vector<double>& ps = momenta)
+{
+   std::vector<double> m1, m2;
+   make_pairs(ms, m1, m2);
+   const int n = m1.size();
+   std::vector<double> result(n);
+
+   for (const auto p: ps) {
+      batch(p, m1.data(), m2.data(), q, result.data(), n);
+      for (int i = 0; i < n; i++) {
+         const double expected = scalar(p, m1[i], m2[i], q);
+         BOOST_TEST_CONTEXT("p = " << p << ", m1 = " << m1[i] << ", m2 = " << m2[i]) {
+            BOOST_CHECK_SMALL(result[i] - expected, tol * std::max(1., std::abs(expected)));
+         }
+      }
+   }
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE( test_a0_batch )
+{
+   const double q = 100.;
+   std::vector<double> result(masses.size());
+
+   softsusy::a0_batch(masses.data(), q, result.data(), masses.size());
+
+   for (std::size_t i = 0; i < masses.size(); i++) {
+      BOOST_CHECK_CLOSE_FRACTION(result[i], softsusy::a0(masses[i], q), 1e-14);
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test_b0_batch )
+{
+   check_pairs(softsusy::b0, softsusy::b0_batch, 100., 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE( test_b0_batch_small_masses )
+{
+   // m^2 < 1, where the regulator of the scalar b0() matters
+   check_pairs(softsusy::b0, softsusy::b0_batch, 100., 1e-9,
+               { 0., 1e-6, 1e-4, 3e-3, 0.01, 0.1, 0.5, 0.9, 91. },
+               { 1e-4, 1e-3, 0.02, 0.1, 1., 91. });
+}
+
+BOOST_AUTO_TEST_CASE( test_b1_batch )
+{
+   check_pairs(softsusy::b1, softsusy::b1_batch, 100., 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE( test_b22_batch )
+{
+   check_pairs(softsusy::b22, softsusy::b22_batch, 100., 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE( test_b22_batch_small_momentum )
+{
+   // p^2 << |m2^2 - m1^2|, where the p-dependent term of b22 cancels
+   check_pairs(softsusy::b22, softsusy::b22_batch, 100., 1e-9,
+               { 0.009, 0.1, 1., 91., 6893.74 },
+               { 1e-3, 0.649, 1., 10. });
+
+   const double m1[] = { 6893.74, 0.009, 2078.69, 0.632871 };
+   const double m2[] = { 0.009, 6893.74, 0.632871, 2078.69 };
+   double result[4];
+
+   for (const auto q: { 1., 91., 1000., 6893.74 }) {
+      softsusy::b22_batch(0.649, m1, m2, q, result, 4);
+      for (int i = 0; i < 4; i++) {
+         BOOST_CHECK_CLOSE_FRACTION(result[i], softsusy::b22(0.649, m1[i], m2[i], q), 1e-14);
+      }
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test_batch_chunks )
+{
+   // more lanes than processed at once
+   const int n = 1000;
+   std::vector<double> m1(n), m2(n), result(n);
+
+   for (int i = 0; i < n; i++) {
+      m1[i] = 10. + i;
+      m2[i] = 2000. - i;
+   }
+
+   softsusy::b0_batch(91., m1.data(), m2.data(), 100., result.data(), n);
+
+   for (int i = 0; i < n; i++) {
+      BOOST_CHECK_CLOSE_FRACTION(result[i], softsusy::b0(91., m1[i], m2[i], 100.), 1e-10);
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test_batch_benchmark )
+{
+   // 6 x 6 mass pairs, as in a sfermion self-energy
+   const std::vector<double> msf = { 200., 350., 500., 800., 1200., 2000. };
+   std::vector<double> m1, m2;
+   for (const auto x1: msf) {
+      for (const auto x2: msf) {
+         m1.push_back(x1);
+         m2.push_back(x2);
+      }
+   }
+
+   const int n = m1.size();
+   const int repetitions = 10000;
+   const double q = 1000.;
+   std::vector<double> result(n);
+   double sum_scalar = 0., sum_batch = 0.;
+
+   Stopwatch sw;
+
+   sw.start();
+   for (int r = 0; r < repetitions; r++) {
+      const double p = 100. + r % 1000;
+      for (int i = 0; i < n; i++) {
+         sum_scalar += softsusy::b0(p, m1[i], m2[i], q);
+      }
+   }
+   sw.stop();
+   const double time_scalar = sw.get_time_in_seconds();
+
+   sw.start();
+   for (int r = 0; r < repetitions; r++) {
+      const double p = 100. + r % 1000;
+      softsusy::b0_batch(p, m1.data(), m2.data(), q, result.data(), n);
+      for (int i = 0; i < n; i++) {
+         sum_batch += result[i];
+      }
+   }
+   sw.stop();
+   const double time_batch = sw.get_time_in_seconds();
+
+   BOOST_TEST_MESSAGE("b0 for " << repetitions << " x " << n << " mass pairs:\n"
+                      << "   scalar: " << time_scalar << "s\n"
+                      << "   batch : " << time_batch << "s");
+
+   BOOST_CHECK_CLOSE_FRACTION(sum_scalar, sum_batch, 1e-10);
+}
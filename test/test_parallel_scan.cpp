@@ -0,0 +1,164 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_parallel_scan
+
+#include <boost/test/unit_test.hpp>
+
+#include "parallel_scan.hpp"
+#include "stopwatch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace flexiblesusy;
+
+namespace {
+
+struct Worker_state {
+   int number_of_points{0};
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(test_serial)
+{
+   const std::size_t N = 100;
+   std::vector<std::size_t> indices;
+
+   Parallel_scan scan(0);
+   scan.run(N,
+            [] () { return Worker_state(); },
+            [] (Worker_state& s, std::size_t i) { s.number_of_points++; return 2*i; },
+            [&indices] (std::size_t i, std::size_t r) {
+               BOOST_CHECK_EQUAL(r, 2*i);
+               indices.push_back(i);
+            });
+
+   BOOST_REQUIRE_EQUAL(indices.size(), N);
+
+   for (std::size_t i = 0; i < N; i++)
+      BOOST_CHECK_EQUAL(indices[i], i);
+}
+
+BOOST_AUTO_TEST_CASE(test_input_order)
+{
+   const std::size_t N = 1000;
+   std::vector<std::size_t> indices;
+
+   Parallel_scan scan(std::thread::hardware_concurrency(),
+                      Parallel_scan::Output_order::input);
+   scan.run(N,
+            [] () { return Worker_state(); },
+            [] (Worker_state&, std::size_t i) {
+               // points with very different run times
+               if (i % 7 == 0)
+                  std::this_thread::sleep_for(std::chrono::microseconds(500));
+               return 2*i;
+            },
+            [&indices] (std::size_t i, std::size_t r) {
+               BOOST_CHECK_EQUAL(r, 2*i);
+               indices.push_back(i);
+            });
+
+   BOOST_REQUIRE_EQUAL(indices.size(), N);
+
+   for (std::size_t i = 0; i < N; i++)
+      BOOST_CHECK_EQUAL(indices[i], i);
+}
+
+BOOST_AUTO_TEST_CASE(test_completion_order)
+{
+   const std::size_t N = 1000;
+   std::vector<int> count(N, 0);
+
+   Parallel_scan scan(std::thread::hardware_concurrency(),
+                      Parallel_scan::Output_order::completion);
+   scan.run(N,
+            [] () { return Worker_state(); },
+            [] (Worker_state&, std::size_t i) { return 2*i; },
+            [&count] (std::size_t i, std::size_t r) {
+               BOOST_CHECK_EQUAL(r, 2*i);
+               count.at(i)++;
+            });
+
+   for (std::size_t i = 0; i < N; i++)
+      BOOST_CHECK_EQUAL(count[i], 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_one_state_per_worker)
+{
+   const std::size_t N = 100;
+   const std::size_t n_threads = 4;
+   std::atomic<int> number_of_states{0};
+
+   Parallel_scan scan(n_threads);
+   scan.run(N,
+            [&number_of_states] () { number_of_states++; return Worker_state(); },
+            [] (Worker_state&, std::size_t i) { return i; },
+            [] (std::size_t, std::size_t) {});
+
+   BOOST_CHECK_EQUAL(number_of_states, static_cast<int>(n_threads));
+}
+
+BOOST_AUTO_TEST_CASE(test_exception)
+{
+   Parallel_scan scan(4);
+
+   BOOST_CHECK_THROW(
+      scan.run(100,
+               [] () { return Worker_state(); },
+               [] (Worker_state&, std::size_t i) -> std::size_t {
+                  if (i == 42)
+                     throw std::runtime_error("point 42 failed");
+                  return i;
+               },
+               [] (std::size_t, std::size_t) {}),
+      std::runtime_error);
+}
+
+template <typename F>
+double measure_time(F&& f)
+{
+   flexiblesusy::Stopwatch s;
+   s.start();
+   f();
+   s.stop();
+
+   return s.get_time_in_seconds();
+}
+
+BOOST_AUTO_TEST_CASE(test_unbalanced_benchmark)
+{
+   const std::size_t N = 200;
+   std::vector<std::size_t> a(N), b(N);
+
+   // the first quarter of the points takes 10 times longer than the rest
+   const auto run_point = [N] (Worker_state&, std::size_t i) {
+      const int ms = i < N/4 ? 10 : 1;
+      std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+      return i;
+   };
+
+   const double time_parallel = measure_time([&] () {
+      Parallel_scan(std::thread::hardware_concurrency()).run(
+         N, [] () { return Worker_state(); }, run_point,
+         [&a] (std::size_t i, std::size_t r) { a[i] = r; });
+   });
+
+   const double time_sequential = measure_time([&] () {
+      Parallel_scan(0).run(
+         N, [] () { return Worker_state(); }, run_point,
+         [&b] (std::size_t i, std::size_t r) { b[i] = r; });
+   });
+
+   for (std::size_t i = 0; i < N; i++)
+      BOOST_CHECK_EQUAL(a[i], b[i]);
+
+   BOOST_TEST_MESSAGE("parallel scan  : " << time_parallel << "s");
+   BOOST_TEST_MESSAGE("sequential scan: " << time_sequential << "s");
+
+   if (std::thread::hardware_concurrency() > 1)
+      BOOST_CHECK_LT(time_parallel, time_sequential);
+}
@@ -0,0 +1,148 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_polylog_batch
+
+#include <boost/test/unit_test.hpp>
+
+#include "dilog.hpp"
+#include "Li4.hpp"
+#include "trilog.hpp"
+#include "stopwatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+using namespace flexiblesusy;
+
+namespace {
+
+const double PI = 3.141592653589793;
+
+/// equidistant points in [start, stop]
+std::vector<double> lin_space(double start, double stop, int n)
+{
+   std::vector<double> v(n);
+   for (int i = 0; i < n; i++) {
+      v[i] = start + (stop - start) * i / (n - 1);
+   }
+   return v;
+}
+
+/// points on a grid in the complex plane
+std::vector<std::complex<double>> complex_grid()
+{
+   std::vector<std::complex<double>> v;
+   for (const auto re: lin_space(-5., 5., 41)) {
+      for (const auto im: lin_space(-5., 5., 41)) {
+         v.emplace_back(re, im);
+      }
+   }
+   v.emplace_back(1., 0.);
+   v.emplace_back(-1., 0.);
+   v.emplace_back(0.5, 0.);
+   return v;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE( test_dilog_real_batch )
+{
+   auto x = lin_space(-10., 10., 2001);
+   for (const auto xi: { -1e10, -1., -1e-10, 0., 1e-10, 0.5, 1. - 1e-10, 1., 2., 1e10 }) {
+      x.push_back(xi);
+   }
+
+   std::vector<double> result(x.size());
+   dilog(x.data(), result.data(), x.size());
+
+   for (std::size_t i = 0; i < x.size(); i++) {
+      BOOST_CHECK_EQUAL(result[i], dilog(x[i]));
+   }
+
+   BOOST_CHECK_EQUAL(result[x.size() - 7], 0.);
+   BOOST_CHECK_EQUAL(result[x.size() - 3], PI*PI/6);
+}
+
+BOOST_AUTO_TEST_CASE( test_dilog_complex_batch )
+{
+   const auto z = complex_grid();
+   std::vector<std::complex<double>> result(z.size());
+   dilog(z.data(), result.data(), z.size());
+
+   for (std::size_t i = 0; i < z.size(); i++) {
+      BOOST_CHECK_EQUAL(result[i], dilog(z[i]));
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test_trilog_Li4_batch )
+{
+   const auto z = complex_grid();
+   std::vector<std::complex<double>> result(z.size());
+
+   trilog(z.data(), result.data(), z.size());
+   for (std::size_t i = 0; i < z.size(); i++) {
+      BOOST_CHECK_EQUAL(result[i], trilog(z[i]));
+   }
+
+   Li4(z.data(), result.data(), z.size());
+   for (std::size_t i = 0; i < z.size(); i++) {
+      BOOST_CHECK_EQUAL(result[i], Li4(z[i]));
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test_clausen_2_batch )
+{
+   auto x = lin_space(-10., 10., 2001);
+   for (const auto xi: { 0., 1e-10, PI/2, 2*PI/3, PI - 1e-8, PI, PI + 1e-8, 2*PI, 7*PI }) {
+      x.push_back(xi);
+   }
+
+   std::vector<double> result(x.size());
+   clausen_2(x.data(), result.data(), x.size());
+
+   for (std::size_t i = 0; i < x.size(); i++) {
+      BOOST_TEST_CONTEXT("x = " << x[i]) {
+         BOOST_CHECK_SMALL(result[i] - clausen_2(x[i]), 1e-14);
+      }
+   }
+
+   // Catalan's constant
+   BOOST_CHECK_CLOSE_FRACTION(result[x.size() - 7], 0.91596559417721901505, 1e-15);
+   BOOST_CHECK_EQUAL(result[x.size() - 4], 0.);
+}
+
+BOOST_AUTO_TEST_CASE( test_clausen_2_batch_benchmark )
+{
+   const int n = 1000000;
+   auto x = lin_space(-10., 10., n);
+   // unsorted arguments, such that branches are not predictable
+   std::shuffle(x.begin(), x.end(), std::mt19937(1));
+
+   std::vector<double> result(n);
+   double sum_scalar = 0., sum_batch = 0.;
+
+   Stopwatch sw;
+
+   sw.start();
+   for (int i = 0; i < n; i++) {
+      sum_scalar += clausen_2(x[i]);
+   }
+   sw.stop();
+   const double time_scalar = sw.get_time_in_seconds();
+
+   sw.start();
+   clausen_2(x.data(), result.data(), n);
+   for (int i = 0; i < n; i++) {
+      sum_batch += result[i];
+   }
+   sw.stop();
+   const double time_batch = sw.get_time_in_seconds();
+
+   BOOST_TEST_MESSAGE("clausen_2 for " << n << " arguments:\n"
+                      << "   scalar: " << time_scalar << "s\n"
+                      << "   batch : " << time_batch << "s");
+
+   BOOST_CHECK_SMALL(sum_scalar - sum_batch, 1e-8);
+}
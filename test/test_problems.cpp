@@ -33,3 +33,33 @@ BOOST_AUTO_TEST_CASE( test_initialization )
    BOOST_CHECK(!problems.no_ewsb());
    BOOST_CHECK(!problems.no_perturbative());
 }
+
+BOOST_AUTO_TEST_CASE( test_flags )
+{
+   const Dummy_names dummy_names(2);
+   Problems problems("DummyModel", &dummy_names, &dummy_names);
+
+   const auto names = problems.get_flag_names();
+
+   BOOST_REQUIRE_EQUAL(names.size(), 4*2 + 6);
+   BOOST_CHECK_EQUAL(names[0], "BadMass(P)");
+   BOOST_CHECK_EQUAL(names[5], "PoleTachyon(P)");
+   BOOST_CHECK_EQUAL(names[8], "NoEWSB");
+   BOOST_CHECK_EQUAL(names[13], "NonPerturbativeParameters");
+
+   BOOST_CHECK(problems.get_flags() == std::vector<double>(names.size(), 0.));
+
+   problems.flag_pole_tachyon(1);
+   problems.flag_no_ewsb();
+   problems.flag_non_perturbative_parameter(0, 4., 1000., 3.5);
+   problems.flag_non_perturbative_parameter(1, 5., 1000., 3.5);
+
+   const auto flags = problems.get_flags();
+
+   BOOST_REQUIRE_EQUAL(flags.size(), names.size());
+   BOOST_CHECK_EQUAL(flags[4], 0.);
+   BOOST_CHECK_EQUAL(flags[5], 1.);
+   BOOST_CHECK_EQUAL(flags[8], 1.);
+   BOOST_CHECK_EQUAL(flags[9], 0.);
+   BOOST_CHECK_EQUAL(flags[13], 2.);
+}
@@ -0,0 +1,217 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_profiling
+
+#include <boost/test/unit_test.hpp>
+
+#include "profiling.hpp"
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace flexiblesusy;
+using namespace flexiblesusy::profiling;
+
+BOOST_AUTO_TEST_CASE( test_profile )
+{
+   Profile profile;
+
+   BOOST_CHECK(profile.empty());
+
+   profile.add_time("a", 1.);
+   profile.add_time("a", 2.);
+   profile.add_time("b", 0.5);
+   profile.add_count("n", 3);
+   profile.add_count("n", 4);
+
+   BOOST_REQUIRE_EQUAL(profile.get_regions().size(), 2);
+   BOOST_CHECK_EQUAL(profile.get_regions().at("a").calls, 2);
+   BOOST_CHECK_EQUAL(profile.get_regions().at("a").seconds, 3.);
+   BOOST_CHECK_EQUAL(profile.get_regions().at("b").calls, 1);
+   BOOST_CHECK_EQUAL(profile.get_counters().at("n"), 7);
+
+   profile.clear();
+   BOOST_CHECK(profile.empty());
+}
+
+BOOST_AUTO_TEST_CASE( test_scoped_timer )
+{
+   thread_profile().clear();
+
+   {
+      Scoped_timer timer("sleep");
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+   }
+
+   const auto& regions = thread_profile().get_regions();
+   BOOST_REQUIRE_EQUAL(regions.count("sleep"), 1);
+   BOOST_CHECK_EQUAL(regions.at("sleep").calls, 1);
+   BOOST_CHECK_GE(regions.at("sleep").seconds, 0.01);
+
+   // other threads have their own profile
+   bool other_empty = false;
+   std::thread t([&other_empty] { other_empty = thread_profile().empty(); });
+   t.join();
+   BOOST_CHECK(other_empty);
+
+   thread_profile().clear();
+}
+
+BOOST_AUTO_TEST_CASE( test_process_profile )
+{
+   clear_process_profile();
+   thread_profile().clear();
+
+   const int number_of_threads = 4;
+   std::vector<std::thread> threads;
+
+   for (int i = 0; i < number_of_threads; i++) {
+      threads.emplace_back([i] {
+         thread_profile().add_time("a", 1.);
+         thread_profile().add_count("n", i);
+         merge_thread_profile();
+         // merged profile is cleared
+         BOOST_CHECK(thread_profile().empty());
+      });
+   }
+
+   for (auto& t: threads) {
+      t.join();
+   }
+
+   const Profile profile = get_process_profile();
+   BOOST_CHECK_EQUAL(profile.get_regions().at("a").calls, number_of_threads);
+   BOOST_CHECK_EQUAL(profile.get_regions().at("a").seconds, number_of_threads * 1.);
+   BOOST_CHECK_EQUAL(profile.get_counters().at("n"), 6);
+
+#ifdef ENABLE_PROFILING
+   // pool threads merge their profiles after each task
+   {
+      Thread_pool pool(2);
+      pool.parallel_for(0, 100, [] (std::size_t) { PROFILE_COUNT("pool", 1); }, 1);
+   }
+   merge_thread_profile();
+   BOOST_CHECK_EQUAL(get_process_profile().get_counters().at("pool"), 100);
+#endif
+
+   clear_process_profile();
+   BOOST_CHECK(get_process_profile().empty());
+}
+
+BOOST_AUTO_TEST_CASE( test_json )
+{
+   Profile profile;
+   profile.add_time("run \"a\"", 0.25);
+   profile.add_count("n", 2);
+
+   BOOST_CHECK_EQUAL(
+      profile.to_json(),
+      R"({"regions": {"run \"a\"": {"calls": 1, "seconds": 0.25}}, "counters": {"n": 2}})");
+
+   BOOST_CHECK_EQUAL(Profile().to_json(), R"({"regions": {}, "counters": {}})");
+}
+
+BOOST_AUTO_TEST_CASE( test_slha_block )
+{
+   Profile profile;
+   profile.add_time("a", 0.25);
+   profile.add_time("b", 0.5);
+   profile.add_time("b", 0.5);
+   profile.add_count("n", 2);
+
+   std::istringstream istr(profile.to_slha_block("Prof"));
+   std::string line;
+
+   std::getline(istr, line);
+   BOOST_CHECK_EQUAL(line, "Block Prof");
+
+   int i = 0, j = 0;
+   double value = 0.;
+   std::string comment;
+
+   const int expected_i[] = {1, 1, 2, 2, 3};
+   const int expected_j[] = {1, 2, 1, 2, 1};
+   const double expected_value[] = {1, 0.25, 2, 1., 2};
+
+   for (int k = 0; k < 5; k++) {
+      BOOST_REQUIRE(std::getline(istr, line));
+      std::istringstream lstr(line);
+      lstr >> i >> j >> value >> comment;
+      BOOST_CHECK_EQUAL(i, expected_i[k]);
+      BOOST_CHECK_EQUAL(j, expected_j[k]);
+      BOOST_CHECK_EQUAL(value, expected_value[k]);
+      BOOST_CHECK_EQUAL(comment, "#");
+   }
+
+   BOOST_CHECK(!std::getline(istr, line));
+}
+
+BOOST_AUTO_TEST_CASE( test_bins )
+{
+   BOOST_CHECK_EQUAL(Scan_profile::get_bin(0.), 0);
+   BOOST_CHECK_EQUAL(Scan_profile::get_bin(1e-7), 0);
+   BOOST_CHECK_EQUAL(Scan_profile::get_bin(1.1e-6), 1);
+   BOOST_CHECK_EQUAL(Scan_profile::get_bin(1.1e-5), 1 + Scan_profile::bins_per_decade);
+   BOOST_CHECK_EQUAL(Scan_profile::get_bin(1e10), Scan_profile::number_of_bins - 1);
+
+   for (int b = 1; b < Scan_profile::number_of_bins - 1; b++) {
+      const double lo = Scan_profile::get_lower_bin_edge(b);
+      const double hi = Scan_profile::get_lower_bin_edge(b + 1);
+      BOOST_CHECK_EQUAL(Scan_profile::get_bin(std::sqrt(lo*hi)), b);
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test_scan_profile )
+{
+   Scan_profile scan;
+
+   for (int i = 1; i <= 10; i++) {
+      Profile profile;
+      profile.add_time("a", 1e-3 * i);
+      profile.add_time("a", 1e-3 * i);
+      profile.add_count("n", i);
+      if (i % 2 == 0) {
+         profile.add_time("b", 1.);
+      }
+      scan.add(profile);
+   }
+
+   BOOST_CHECK_EQUAL(scan.get_number_of_points(), 10);
+
+   const auto& a = scan.get_histograms().at("a");
+   BOOST_CHECK_EQUAL(a.points, 10);
+   BOOST_CHECK_EQUAL(a.calls, 20);
+   BOOST_CHECK_CLOSE_FRACTION(a.seconds, 0.11, 1e-12);
+   BOOST_CHECK_CLOSE_FRACTION(a.min, 2e-3, 1e-12);
+   BOOST_CHECK_CLOSE_FRACTION(a.max, 2e-2, 1e-12);
+
+   long long sum = 0;
+   for (const auto n: a.bins) {
+      sum += n;
+   }
+   BOOST_CHECK_EQUAL(sum, 10);
+
+   const auto& b = scan.get_histograms().at("b");
+   BOOST_CHECK_EQUAL(b.points, 5);
+   BOOST_CHECK_EQUAL(b.bins[Scan_profile::get_bin(1.)], 5);
+
+   BOOST_CHECK_EQUAL(scan.get_counters().at("n").total, 55);
+   BOOST_CHECK_EQUAL(scan.get_counters().at("n").max, 10);
+
+   std::ostringstream ostr;
+   scan.print(ostr);
+   BOOST_TEST_MESSAGE(ostr.str());
+   BOOST_CHECK(ostr.str().find("Profile of 10 points") != std::string::npos);
+
+   const std::string json = scan.to_json();
+   BOOST_CHECK(json.find("\"points\": 10") != std::string::npos);
+   BOOST_CHECK(json.find("\"n\": {\"total\": 55, \"max\": 10}") != std::string::npos);
+
+   scan.clear();
+   BOOST_CHECK_EQUAL(scan.get_number_of_points(), 0);
+   BOOST_CHECK(scan.get_histograms().empty());
+}
@@ -0,0 +1,196 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_rg_trajectory
+
+#include <boost/test/unit_test.hpp>
+
+#include "betafunction.hpp"
+#include "error.hpp"
+#include "rg_trajectory.hpp"
+
+#include <Eigen/Core>
+
+#include <cmath>
+
+using namespace flexiblesusy;
+
+namespace {
+
+const double oneOver16PiSqr = 1. / (16. * M_PI * M_PI);
+
+/// one-loop running of the MSSM gauge couplings
+class Gauge_model : public Beta_function {
+public:
+   Gauge_model() : g(3), b(3) {
+      g << 0.46, 0.65, 1.2;
+      b << 33./5., 1., -3.;
+      set_scale(91.);
+      set_number_of_parameters(3);
+      set_loops(1);
+   }
+   virtual ~Gauge_model() = default;
+   virtual Eigen::ArrayXd get() const override { return g; }
+   virtual void set(const Eigen::ArrayXd& s) override { g = s; }
+   virtual Eigen::ArrayXd beta() const override {
+      ++number_of_beta_calls;
+      return oneOver16PiSqr * b * g.cube();
+   }
+
+   /// analytic solution at the given scale, starting from g0 at q0
+   Eigen::ArrayXd analytic(const Eigen::ArrayXd& g0, double q0, double q) const {
+      const double t = std::log(q / q0);
+      return (1. / (1. / g0.square() - 2. * oneOver16PiSqr * b * t)).sqrt();
+   }
+
+   mutable long number_of_beta_calls{0};
+
+private:
+   Eigen::ArrayXd g, b;
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE( test_empty )
+{
+   RG_trajectory trajectory;
+
+   BOOST_CHECK(trajectory.empty());
+   BOOST_CHECK(!trajectory.covers(100.));
+   BOOST_CHECK_THROW(trajectory.get(100.), OutOfBoundsError);
+}
+
+BOOST_AUTO_TEST_CASE( test_hermite_interpolation_of_quintic )
+{
+   // quintic polynomials are interpolated exactly
+   const auto f = [] (double t) { return 1. + 2.*t - 0.5*t*t + 0.25*t*t*t - 0.1*std::pow(t,5); };
+   const auto df = [] (double t) { return 2. - t + 0.75*t*t - 0.5*std::pow(t,4); };
+   const auto d2f = [] (double t) { return -1. + 1.5*t - 2.*t*t*t; };
+   const auto c = [] (double x) { return Eigen::ArrayXd::Constant(1, x); };
+
+   RG_trajectory trajectory;
+
+   for (double t: {0., 1., 2.5}) {
+      trajectory.add(t, c(f(t)), c(df(t)), c(d2f(t)));
+   }
+
+   BOOST_CHECK_EQUAL(trajectory.size(), 3);
+   BOOST_CHECK_CLOSE_FRACTION(trajectory.get_min_scale(), 1., 1e-15);
+   BOOST_CHECK_CLOSE_FRACTION(trajectory.get_max_scale(), std::exp(2.5), 1e-15);
+
+   for (double t = 0.; t <= 2.5; t += 0.1) {
+      BOOST_CHECK_CLOSE_FRACTION(trajectory.get(std::exp(t))(0), f(t), 1e-12);
+   }
+
+   BOOST_CHECK(!trajectory.covers(std::exp(-0.1)));
+   BOOST_CHECK(!trajectory.covers(std::exp(2.6)));
+   BOOST_CHECK_THROW(trajectory.get(std::exp(2.6)), OutOfBoundsError);
+   BOOST_CHECK_THROW(
+      trajectory.add(1., c(0.), c(0.), c(0.)),
+      SetupError);
+}
+
+BOOST_AUTO_TEST_CASE( test_run_and_record )
+{
+   const double q_low = 91., q_high = 2e16;
+
+   Gauge_model recorded, direct;
+   const Eigen::ArrayXd g0(recorded.get());
+
+   RG_trajectory trajectory;
+   recorded.run_and_record(q_high, trajectory);
+
+   // end point agrees with run_to()
+   direct.run_to(q_high);
+
+   BOOST_CHECK_EQUAL(recorded.get_scale(), q_high);
+   for (int i = 0; i < 3; i++) {
+      BOOST_CHECK_CLOSE_FRACTION(recorded.get()(i), direct.get()(i), 1e-5);
+   }
+
+   BOOST_CHECK(trajectory.size() >= 2);
+   BOOST_CHECK(trajectory.covers(q_low));
+   BOOST_CHECK(trajectory.covers(q_high));
+
+   // interpolation does not evaluate beta functions
+   const long calls = recorded.number_of_beta_calls;
+
+   for (int n = 0; n <= 100; n++) {
+      const double q = q_low * std::pow(q_high / q_low, n / 100.);
+      const Eigen::ArrayXd g_interp(trajectory.get(q));
+      const Eigen::ArrayXd g_exact(recorded.analytic(g0, q_low, q));
+
+      for (int i = 0; i < 3; i++) {
+         BOOST_CHECK_CLOSE_FRACTION(g_interp(i), g_exact(i), 1e-5);
+      }
+   }
+
+   BOOST_CHECK_EQUAL(recorded.number_of_beta_calls, calls);
+}
+
+BOOST_AUTO_TEST_CASE( test_run_and_record_downwards )
+{
+   const double q_high = 2e16, q_low = 91.;
+
+   Gauge_model model;
+   model.run_to(q_high);
+   const Eigen::ArrayXd g_high(model.get());
+
+   RG_trajectory trajectory;
+   model.run_and_record(q_low, trajectory);
+
+   for (int n = 0; n <= 20; n++) {
+      const double q = q_low * std::pow(q_high / q_low, n / 20.);
+      const Eigen::ArrayXd g_interp(trajectory.get(q));
+      const Eigen::ArrayXd g_exact(model.analytic(g_high, q_high, q));
+
+      for (int i = 0; i < 3; i++) {
+         BOOST_CHECK_CLOSE_FRACTION(g_interp(i), g_exact(i), 1e-5);
+      }
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test_run_and_record_zero_loops )
+{
+   Gauge_model model;
+   model.set_loops(0);
+   const Eigen::ArrayXd g0(model.get());
+
+   RG_trajectory trajectory;
+   model.run_and_record(1000., trajectory);
+
+   BOOST_CHECK_EQUAL(model.get_scale(), 1000.);
+   BOOST_CHECK_EQUAL(model.number_of_beta_calls, 0);
+
+   const Eigen::ArrayXd g(trajectory.get(300.));
+
+   for (int i = 0; i < 3; i++) {
+      BOOST_CHECK_EQUAL(g(i), g0(i));
+   }
+}
+
+BOOST_AUTO_TEST_CASE( test_run_and_record_failure )
+{
+   // the U(1) coupling has a Landau pole at Q ~ 10^26 GeV
+   const double q_low = 91., q_high = 1e40;
+
+   Gauge_model model;
+   const Eigen::ArrayXd g0(model.get());
+
+   RG_trajectory trajectory;
+   BOOST_CHECK_THROW(model.run_and_record(q_high, trajectory), Error);
+
+   // model is unchanged
+   BOOST_CHECK_EQUAL(model.get_scale(), q_low);
+   BOOST_CHECK((model.get() == g0).all());
+
+   // trajectory contains the flow up to the failure
+   BOOST_REQUIRE(!trajectory.empty());
+   BOOST_CHECK(trajectory.covers(1e20));
+   BOOST_CHECK(!trajectory.covers(q_high));
+
+   const Eigen::ArrayXd g_interp(trajectory.get(1e20));
+   const Eigen::ArrayXd g_exact(model.analytic(g0, q_low, 1e20));
+
+   for (int i = 0; i < 3; i++) {
+      BOOST_CHECK_CLOSE_FRACTION(g_interp(i), g_exact(i), 1e-5);
+   }
+}
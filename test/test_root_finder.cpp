@@ -69,3 +69,48 @@ BOOST_AUTO_TEST_CASE( test_number_of_calls )
       BOOST_TEST_MESSAGE("solver type " << i << " used " << number_of_calls << " calls");
    }
 }
+
+BOOST_AUTO_TEST_CASE( test_jacobian )
+{
+   const double precision = 1.0e-5;
+   int number_of_jacobian_calls = 0;
+
+   auto jacobian = [&number_of_jacobian_calls](const EV2_t& x) -> Eigen::Matrix<double,2,2> {
+      number_of_jacobian_calls++;
+      Eigen::Matrix<double,2,2> j;
+      j << 2*x(0) - 5.0, 0, 0, 2*x(1) - 1.0;
+      return j;
+   };
+
+   Eigen::Matrix<double,2,1> start;
+   start << 10, 10;
+
+   Root_finder<2>::Solver_type solvers[] =
+      { Root_finder<2>::GSLHybridSJ,
+        Root_finder<2>::GSLNewtonJ };
+
+   for (std::size_t i = 0; i < sizeof(solvers)/sizeof(*solvers); ++i) {
+      // analytic Jacobian
+      Root_finder<2> root_finder(parabola, jacobian, 100, precision, solvers[i]);
+      number_of_calls = 0;
+      number_of_jacobian_calls = 0;
+      BOOST_REQUIRE(root_finder.find_root(start) == GSL_SUCCESS);
+      BOOST_CHECK_CLOSE_FRACTION(root_finder.get_solution()(0), 5.0, precision);
+      BOOST_CHECK_CLOSE_FRACTION(root_finder.get_solution()(1), 1.0, precision);
+      BOOST_CHECK_GT(number_of_jacobian_calls, 0);
+      const int calls_analytic = number_of_calls;
+
+      // Jacobian from finite differences
+      root_finder.set_jacobian(nullptr);
+      number_of_calls = 0;
+      BOOST_REQUIRE(root_finder.find_root(start) == GSL_SUCCESS);
+      BOOST_CHECK_CLOSE_FRACTION(root_finder.get_solution()(0), 5.0, precision);
+      BOOST_CHECK_CLOSE_FRACTION(root_finder.get_solution()(1), 1.0, precision);
+      const int calls_numeric = number_of_calls;
+
+      BOOST_CHECK_LT(calls_analytic, calls_numeric);
+      BOOST_TEST_MESSAGE(root_finder.name() << " used " << calls_analytic
+                         << " calls with analytic and " << calls_numeric
+                         << " calls with numeric Jacobian");
+   }
+}
@@ -10,6 +10,7 @@
 #include "linalg2.hpp"
 #include "stopwatch.hpp"
 #include "wrappers.hpp"
+#include <sstream>
 #include <string>
 #include <Eigen/Core>
 
@@ -397,9 +398,9 @@ BOOST_AUTO_TEST_CASE( test_processor_doubled )
 
 /**
  * This test compares the speed of reading an array from a long SLHA
- * block using a) a tuple processor and b) a for loop.  The tuple
- * processor is more complicated to use, but is more than 1000 times
- * faster than the for loop.
+ * block using a) a tuple processor and b) a for loop.  Since the
+ * entries are indexed, the for loop is not much slower than the tuple
+ * processor.
  */
 BOOST_AUTO_TEST_CASE( test_processor_vs_loop )
 {
@@ -443,7 +444,113 @@ BOOST_AUTO_TEST_CASE( test_processor_vs_loop )
    BOOST_TEST_MESSAGE("time using the tuple processor: " << processor_time << " s");
    BOOST_TEST_MESSAGE("time using the for loop: " << loop_time << " s");
 
-   BOOST_CHECK_LT(10 * processor_time, loop_time);
+   BOOST_CHECK_LT(loop_time, 10 * processor_time);
+}
+
+BOOST_AUTO_TEST_CASE( test_index )
+{
+   std::istringstream istr(
+      "Block SMINPUTS\n"
+      "   1   1.27934000E+02   # alpha_em^(-1)\n"
+      "Block MSOFTIN Q= 1000\n"
+      "   1   5.00000000E+02   # M1\n"
+      "   2   6.00000000E+02   # M2\n"
+      "Block msoftin\n"
+      "   2   7.00000000E+02   # M2\n"
+      "  21   8.00000000E+02   # mHd2\n");
+
+   SLHA_io reader;
+   reader.read_from_stream(istr);
+
+   // block names are case-insensitive
+   BOOST_CHECK(reader.block_exists("MSOFTIN"));
+   BOOST_CHECK(reader.block_exists("MSoftIn"));
+   BOOST_CHECK(!reader.block_exists("EXTPAR"));
+
+   // the last entry wins
+   BOOST_CHECK_EQUAL(reader.read_entry("MSOFTIN", 1), 500.);
+   BOOST_CHECK_EQUAL(reader.read_entry("MSOFTIN", 2), 700.);
+   BOOST_CHECK_EQUAL(reader.read_entry("msoftin", 21), 800.);
+   BOOST_CHECK_EQUAL(reader.read_entry("MSOFTIN", 3), 0.);
+   BOOST_CHECK_EQUAL(reader.read_entry("EXTPAR", 1), 0.);
+   BOOST_CHECK_EQUAL(reader.read_scale("MSOFTIN"), 1000.);
+
+   Eigen::Matrix<double,3,1> vec(Eigen::Matrix<double,3,1>::Zero());
+   reader.read_block("MSOFTIN", vec);
+   BOOST_CHECK_EQUAL(vec(0), 500.);
+   BOOST_CHECK_EQUAL(vec(1), 700.);
+   BOOST_CHECK_EQUAL(vec(2), 0.);
+
+   // copies have their own index
+   const SLHA_io copy(reader);
+   reader.clear();
+   BOOST_CHECK(!reader.block_exists("MSOFTIN"));
+   BOOST_CHECK_EQUAL(copy.read_entry("MSOFTIN", 2), 700.);
+
+   // modified blocks are found
+   SLHA_io writer(copy);
+   writer.set_block("Block MSOFTIN\n   2   9.00000000E+02\n");
+   BOOST_CHECK_EQUAL(writer.read_entry("MSOFTIN", 2), 900.);
+   BOOST_CHECK_EQUAL(writer.read_entry("MSOFTIN", 1), 0.);
+   BOOST_CHECK_EQUAL(writer.read_entry("SMINPUTS", 1), 127.934);
+}
+
+/**
+ * This test measures the time to read all entries of a large SLHA
+ * file with many blocks via read_entry() and compares it to a
+ * linear search for each block.
+ */
+BOOST_AUTO_TEST_CASE( test_index_benchmark )
+{
+   const int number_of_blocks = 200;
+   const int number_of_entries = 20;
+
+   std::ostringstream ostr;
+   for (int b = 0; b < number_of_blocks; b++) {
+      ostr << "Block B" << b << " Q= 1000\n";
+      for (int i = 1; i <= number_of_entries; i++) {
+         ostr << "   " << i << "   " << b + 0.01 * i << "   # entry\n";
+      }
+   }
+
+   std::istringstream istr(ostr.str());
+   SLHA_io reader;
+   reader.read_from_stream(istr);
+
+   Stopwatch timer;
+   double sum_index = 0., sum_linear = 0.;
+
+   timer.start();
+   for (int b = 0; b < number_of_blocks; b++) {
+      const std::string name("B" + std::to_string(b));
+      for (int i = 1; i <= number_of_entries; i++) {
+         sum_index += reader.read_entry(name, i);
+      }
+   }
+   timer.stop();
+   const double index_time = timer.get_time_in_seconds();
+
+   const SLHAea::Coll& data = reader.get_data();
+
+   timer.start();
+   for (int b = 0; b < number_of_blocks; b++) {
+      const std::string name("B" + std::to_string(b));
+      for (int i = 1; i <= number_of_entries; i++) {
+         const auto block = data.find(name);
+         const auto line = block->find(SLHAea::Block::key_type(1, std::to_string(i)));
+         sum_linear += std::stod(line->at(1));
+      }
+   }
+   timer.stop();
+   const double linear_time = timer.get_time_in_seconds();
+
+   BOOST_TEST_MESSAGE("reading " << number_of_blocks * number_of_entries
+                      << " entries from " << number_of_blocks << " blocks:\n"
+                      << "   indexed: " << index_time << " s\n"
+                      << "   linear search: " << linear_time << " s");
+
+   BOOST_CHECK_CLOSE_FRACTION(sum_index, sum_linear, 1e-12);
+   BOOST_CHECK_LT(index_time, linear_time);
 }
 
 BOOST_AUTO_TEST_CASE( test_slha_mixing_matrix_convention )
@@ -6,8 +6,16 @@
 #include "thread_pool.hpp"
 #include "stopwatch.hpp"
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 using namespace flexiblesusy;
 
@@ -136,3 +144,195 @@ BOOST_AUTO_TEST_CASE(test_fill_array_benchmark)
 
    BOOST_CHECK_LT(time_parallel, time_sequential);
 }
+
+BOOST_AUTO_TEST_CASE(test_small_task)
+{
+   int result = 0;
+
+   // small callable, stored in-place
+   Small_task t1([&result](){ result += 1; });
+   t1();
+   BOOST_CHECK_EQUAL(result, 1);
+
+   // large callable, stored on the heap
+   std::array<double, 64> a{};
+   a.fill(1.);
+   Small_task t2([&result, a](){ result += static_cast<int>(std::accumulate(a.cbegin(), a.cend(), 0.)); });
+   Small_task t3(std::move(t2));
+   BOOST_CHECK(!t2);
+   t3();
+   BOOST_CHECK_EQUAL(result, 65);
+
+   // move-only callable
+   auto ptr = std::make_unique<int>(2);
+   Small_task t4([p = std::move(ptr), &result](){ result += *p; });
+   t4();
+   BOOST_CHECK_EQUAL(result, 67);
+
+   t4 = std::move(t3);
+   t4();
+   BOOST_CHECK_EQUAL(result, 131);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for)
+{
+   std::vector<double> a(1000, 0.);
+
+   Thread_pool tp(std::thread::hardware_concurrency());
+   tp.parallel_for(0, a.size(), [&a](std::size_t i){ a[i] = i; });
+
+   for (std::size_t i = 0; i < a.size(); i++)
+      BOOST_CHECK_EQUAL(a[i], i);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_0_threads)
+{
+   std::vector<double> a(100, 0.);
+
+   Thread_pool tp(0);
+   tp.parallel_for(0, a.size(), [&a](std::size_t i){ a[i] = i; });
+
+   for (std::size_t i = 0; i < a.size(); i++)
+      BOOST_CHECK_EQUAL(a[i], i);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_exception)
+{
+   Thread_pool tp(2);
+
+   BOOST_CHECK_THROW(
+      tp.parallel_for(0, 100, [](std::size_t i){
+            if (i == 42)
+               throw std::runtime_error("42");
+         }, 1),
+      std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_nested_parallel_for)
+{
+   std::array<std::array<int, 50>, 50> a{};
+
+   Thread_pool tp(2);
+   tp.parallel_for(0, a.size(), [&a, &tp](std::size_t i){
+         tp.parallel_for(0, a[i].size(), [&a, i](std::size_t k){ a[i][k] = i*k; }, 1);
+      }, 1);
+
+   for (std::size_t i = 0; i < a.size(); i++)
+      for (std::size_t k = 0; k < a[i].size(); k++)
+         BOOST_CHECK_EQUAL(a[i][k], i*k);
+}
+
+BOOST_AUTO_TEST_CASE(test_wait_all)
+{
+   std::atomic<int> result{0};
+
+   Thread_pool tp(std::thread::hardware_concurrency());
+
+   for (int k = 0; k < 3; k++) {
+      for (int i = 0; i < 100; i++)
+         tp.run_task([&result](){ result++; });
+      tp.wait_all();
+      BOOST_CHECK_EQUAL(result.load(), 100*(k + 1));
+   }
+}
+
+namespace {
+
+/// thread pool with a single mutex-protected task queue (previous implementation)
+class Reference_thread_pool {
+public:
+   explicit Reference_thread_pool(std::size_t pool_size)
+   {
+      for (std::size_t i = 0; i < pool_size; ++i)
+         threads.emplace_back(
+            [this] () {
+               for (;;) {
+                  std::function<void()> task;
+                  {
+                     std::unique_lock<std::mutex> lock(mutex);
+                     condition.wait(lock, [this]{ return stop || !tasks.empty(); });
+                     if (stop && tasks.empty())
+                        return;
+                     task = std::move(tasks.front());
+                     tasks.pop();
+                  }
+                  task();
+               }
+            });
+   }
+
+   ~Reference_thread_pool()
+   {
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         stop = true;
+      }
+      condition.notify_all();
+      for (auto& t: threads)
+         t.join();
+   }
+
+   template <typename Task>
+   auto run_packaged_task(Task&& task) -> std::future<decltype(task())>
+   {
+      using return_t = decltype(task());
+      auto ptask = std::make_shared<std::packaged_task<return_t()>>([task](){ return task(); });
+      std::future<return_t> fut = ptask->get_future();
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         tasks.emplace([ptask](){ (*ptask)(); });
+      }
+      condition.notify_one();
+      return fut;
+   }
+
+private:
+   std::vector<std::thread> threads{};
+   std::queue<std::function<void()>> tasks{};
+   std::mutex mutex{};
+   std::condition_variable condition{};
+   bool stop{false};
+};
+
+template <typename Pool>
+double run_tiny_tasks(Pool& tp, std::size_t n_tasks)
+{
+   std::vector<std::future<double>> f(n_tasks);
+
+   for (std::size_t i = 0; i < n_tasks; i++)
+      f[i] = tp.run_packaged_task([i](){ return 1.*i; });
+
+   double sum = 0.;
+   for (auto& x: f)
+      sum += x.get();
+
+   return sum;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(test_tiny_tasks_benchmark)
+{
+   const std::size_t n_tasks = 100000;
+   const std::size_t n_threads = std::max(2u, std::thread::hardware_concurrency());
+   double sum_new = 0., sum_ref = 0., sum_pfor = 0.;
+
+   Thread_pool tp(n_threads);
+   Reference_thread_pool rtp(n_threads);
+
+   const double time_new = measure_time([&](){ sum_new = run_tiny_tasks(tp, n_tasks); });
+   const double time_ref = measure_time([&](){ sum_ref = run_tiny_tasks(rtp, n_tasks); });
+
+   std::vector<double> a(n_tasks);
+   const double time_pfor = measure_time([&](){
+         tp.parallel_for(0, n_tasks, [&a](std::size_t i){ a[i] = 1.*i; });
+         sum_pfor = std::accumulate(a.cbegin(), a.cend(), 0.);
+      });
+
+   BOOST_CHECK_EQUAL(sum_new, sum_ref);
+   BOOST_CHECK_EQUAL(sum_pfor, sum_ref);
+
+   BOOST_TEST_MESSAGE("tiny tasks, work-stealing pool  : " << time_new << "s");
+   BOOST_TEST_MESSAGE("tiny tasks, single queue pool   : " << time_ref << "s");
+   BOOST_TEST_MESSAGE("tiny tasks, parallel_for        : " << time_pfor << "s");
+}
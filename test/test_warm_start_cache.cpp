@@ -0,0 +1,260 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_warm_start_cache
+
+#include <boost/test/unit_test.hpp>
+
+#include "convergence_tester.hpp"
+#include "model.hpp"
+#include "single_scale_constraint.hpp"
+#include "two_scale_solver.hpp"
+#include "warm_start_cache.hpp"
+
+#include <cmath>
+#include <limits>
+
+using namespace flexiblesusy;
+
+namespace {
+
+Eigen::ArrayXd make_key(double a, double b)
+{
+   Eigen::ArrayXd key(2);
+   key << a, b;
+   return key;
+}
+
+Warm_start_state make_state(double scale)
+{
+   Warm_start_state state;
+   state.parameters = Eigen::ArrayXd::Constant(3, scale);
+   state.scale = scale;
+   state.constraint_scales = { 2*scale, scale };
+   return state;
+}
+
+/**
+ * Toy model with two parameters x and y, where x runs linearly in
+ * log(Q) with slope y and y does not run.
+ */
+class Toy_model : public Model {
+public:
+   void calculate_spectrum() override {}
+   void clear_problems() override {}
+   std::string name() const override { return "Toy_model"; }
+   void print(std::ostream&) const override {}
+   void run_to(double q, double) override {
+      x += y*std::log(q/scale);
+      scale = q;
+   }
+   void set_precision(double) override {}
+
+   double x{0.}, y{0.}, scale{100.};
+};
+
+/// fixes x at the low scale to the input value
+class Toy_low_constraint : public Single_scale_constraint {
+public:
+   explicit Toy_low_constraint(double x_in_) : x_in(x_in_) {}
+   void apply() override { model->x = x_in; }
+   double get_scale() const override { return 100.; }
+   void set_model(Model* m) override { model = static_cast<Toy_model*>(m); }
+private:
+   Toy_model* model{nullptr};
+   double x_in{0.};
+};
+
+/// fixes y at the high scale, which depends on x at the high scale
+class Toy_high_constraint : public Single_scale_constraint {
+public:
+   void apply() override { model->y = 1. + 0.5*model->x/std::log(1e16/100.); }
+   double get_scale() const override { return 1e16; }
+   void set_model(Model* m) override { model = static_cast<Toy_model*>(m); }
+private:
+   Toy_model* model{nullptr};
+};
+
+/// stops the iteration if y does not change any more
+class Toy_convergence_tester : public Convergence_tester {
+public:
+   explicit Toy_convergence_tester(const Toy_model& m) : model(m) {}
+   bool accuracy_goal_reached() override {
+      const bool reached = std::abs(model.y - last_y) <= 1e-10*std::abs(model.y);
+      last_y = model.y;
+      return reached;
+   }
+   int max_iterations() const override { return 100; }
+   void restart() override { last_y = 0.; }
+private:
+   const Toy_model& model;
+   double last_y{0.};
+};
+
+/**
+ * Solves the toy boundary value problem for the given input.  If a
+ * cache is given, the model is initialized with the solution of the
+ * nearest stored point and the solution is stored afterwards.
+ *
+ * @return number of iterations
+ */
+int solve_toy(double x_in, Toy_model& model, Warm_start_cache* cache)
+{
+   Eigen::ArrayXd key(1);
+   key << x_in;
+
+   model = Toy_model();
+
+   if (cache) {
+      if (const auto* state = cache->find_nearest(key)) {
+         model.x = state->parameters(0);
+         model.y = state->parameters(1);
+         model.scale = state->scale;
+      }
+   }
+
+   Toy_low_constraint low(x_in);
+   Toy_high_constraint high;
+   Toy_convergence_tester tester(model);
+
+   low.set_model(&model);
+   high.set_model(&model);
+
+   RGFlow<Two_scale> solver;
+   solver.set_convergence_tester(&tester);
+   solver.add(&low, &model);
+   solver.add(&high, &model);
+   solver.solve();
+
+   if (cache) {
+      Warm_start_state state;
+      state.parameters = Eigen::ArrayXd(2);
+      state.parameters << model.x, model.y;
+      state.scale = model.scale;
+      cache->add(key, state);
+   }
+
+   return solver.number_of_iterations_done();
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE( test_distance )
+{
+   BOOST_CHECK_EQUAL(Warm_start_cache::distance(make_key(1., 0.), make_key(1., 0.)), 0.);
+   BOOST_CHECK_CLOSE_FRACTION(Warm_start_cache::distance(make_key(100., 10.), make_key(110., 10.)), 10./110., 1e-15);
+   BOOST_CHECK_CLOSE_FRACTION(Warm_start_cache::distance(make_key(100., 10.), make_key(101., 5.)), 0.5, 1e-15);
+   BOOST_CHECK_EQUAL(Warm_start_cache::distance(make_key(0., 1.), make_key(-1., 1.)), 1.);
+
+   const double inf = std::numeric_limits<double>::infinity();
+   BOOST_CHECK_EQUAL(Warm_start_cache::distance(make_key(1., 1.), make_key(inf, 1.)), inf);
+
+   // entries below the absolute scale are compared absolutely
+   BOOST_CHECK_EQUAL(Warm_start_cache::distance(make_key(0., 1.), make_key(0.01, 1.)), 1.);
+   BOOST_CHECK_CLOSE_FRACTION(Warm_start_cache::distance(make_key(0., 1.), make_key(0.01, 1.), 1.), 0.01, 1e-15);
+   BOOST_CHECK_CLOSE_FRACTION(Warm_start_cache::distance(make_key(-0.02, 1.), make_key(0.03, 1.), 1.), 0.05, 1e-15);
+   BOOST_CHECK_CLOSE_FRACTION(Warm_start_cache::distance(make_key(100., 1.), make_key(110., 1.), 1.), 10./110., 1e-15);
+}
+
+BOOST_AUTO_TEST_CASE( test_abs_scale )
+{
+   Warm_start_cache cache(10, 0.1);
+
+   BOOST_CHECK_EQUAL(cache.get_abs_scale(), 1.);
+
+   cache.add(make_key(0., 10.), make_state(1.));
+
+   BOOST_CHECK(cache.find_nearest(make_key(0.05, 10.)) != nullptr);
+   BOOST_CHECK(cache.find_nearest(make_key(0.5, 10.)) == nullptr);
+
+   cache.set_abs_scale(0.);
+   BOOST_CHECK(cache.find_nearest(make_key(0.05, 10.)) == nullptr);
+   BOOST_CHECK(cache.find_nearest(make_key(0., 10.)) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE( test_empty )
+{
+   Warm_start_cache cache;
+
+   BOOST_CHECK(cache.empty());
+   BOOST_CHECK(cache.find_nearest(make_key(1., 1.)) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE( test_find_nearest )
+{
+   Warm_start_cache cache(10, 0.1);
+
+   cache.add(make_key(100., 10.), make_state(1.));
+   cache.add(make_key(200., 10.), make_state(2.));
+   cache.add(make_key(300., 10.), make_state(3.));
+
+   BOOST_CHECK_EQUAL(cache.size(), 3);
+
+   const auto* s1 = cache.find_nearest(make_key(205., 10.));
+   BOOST_REQUIRE(s1);
+   BOOST_CHECK_EQUAL(s1->scale, 2.);
+   BOOST_CHECK_EQUAL(s1->constraint_scales.size(), 2);
+   BOOST_CHECK_EQUAL(s1->constraint_scales[0], 4.);
+   BOOST_CHECK((s1->parameters == 2.).all());
+
+   const auto* s2 = cache.find_nearest(make_key(100., 10.));
+   BOOST_REQUIRE(s2);
+   BOOST_CHECK_EQUAL(s2->scale, 1.);
+
+   // too far away
+   BOOST_CHECK(cache.find_nearest(make_key(250., 10.)) == nullptr);
+   BOOST_CHECK(cache.find_nearest(make_key(200., 20.)) == nullptr);
+
+   // different key size
+   BOOST_CHECK(cache.find_nearest(Eigen::ArrayXd::Constant(3, 200.)) == nullptr);
+
+   cache.set_max_distance(0.5);
+   BOOST_CHECK(cache.find_nearest(make_key(250., 10.)) != nullptr);
+
+   cache.clear();
+   BOOST_CHECK(cache.empty());
+}
+
+BOOST_AUTO_TEST_CASE( test_capacity )
+{
+   Warm_start_cache cache(2, 0.1);
+
+   cache.add(make_key(100., 10.), make_state(1.));
+   cache.add(make_key(200., 10.), make_state(2.));
+   cache.add(make_key(300., 10.), make_state(3.));
+
+   // oldest entry has been removed
+   BOOST_CHECK_EQUAL(cache.size(), 2);
+   BOOST_CHECK(cache.find_nearest(make_key(100., 10.)) == nullptr);
+   BOOST_REQUIRE(cache.find_nearest(make_key(300., 10.)));
+   BOOST_CHECK_EQUAL(cache.find_nearest(make_key(300., 10.))->scale, 3.);
+
+   cache.set_capacity(1);
+   BOOST_CHECK_EQUAL(cache.size(), 1);
+   BOOST_CHECK(cache.find_nearest(make_key(200., 10.)) == nullptr);
+
+   cache.set_capacity(0);
+   cache.add(make_key(100., 10.), make_state(1.));
+   BOOST_CHECK(cache.empty());
+}
+
+BOOST_AUTO_TEST_CASE( test_warm_start_iterations )
+{
+   Warm_start_cache cache;
+   int cold_iterations = 0, warm_iterations = 0;
+
+   for (int i = 0; i <= 20; i++) {
+      const double x_in = 100. + i;
+      Toy_model cold, warm;
+
+      cold_iterations += solve_toy(x_in, cold, nullptr);
+      warm_iterations += solve_toy(x_in, warm, &cache);
+
+      // both runs converge to the same solution
+      BOOST_CHECK_CLOSE_FRACTION(cold.y, warm.y, 1e-9);
+      BOOST_CHECK_CLOSE_FRACTION(cold.x, warm.x, 1e-9);
+   }
+
+   BOOST_TEST_MESSAGE("iterations without warm start: " << cold_iterations
+                      << ", with warm start: " << warm_iterations);
+
+   BOOST_CHECK_LT(warm_iterations, cold_iterations);
+}